@@ -0,0 +1,230 @@
+//
+//  bloom_filter.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "bloom_filter.h"
+#include "mem_stat.h"
+#include "log.h"
+#include <string.h>
+#include <stdatomic.h>
+
+static const uint8_t block_size = 64;       // 块大小[一个缓存行]
+static const uint8_t hash_count = 4;        // 每个键在块内的计数器数量
+static const uint8_t per_block_items = 16;  // 每块期望元素数量[误判率约2%]
+static const uint8_t max_counter = 0x0F;    // 计数器上限[达到后不再增减，避免误删]
+
+/**
+ * @brief 分块计数布隆过滤器[每块128个4位计数器，单个键的所有计数器位于同一块内]
+ */
+struct bloom_filter {
+    uint8_t *blocks;    // 块数组[按缓存行对齐]
+    void *memory;       // 块数组原始地址
+    uint64_t mask;      // 块序号掩码[块数量为2的幂]
+    bloom_stat_t stat;  // 统计信息[查询计数除外]
+    atomic_uint_fast64_t lookups;           // 查询次数[查询可并发执行，单独原子计数]
+    atomic_uint_fast64_t negatives;         // 判定不存在次数
+    atomic_uint_fast64_t false_positives;   // 误判次数
+};
+
+/**
+ * @brief       混合哈希[高32位选块，低28位选块内计数器]
+ * @param key   键
+ * @return      哈希值
+ */
+static inline uint64_t mix_hash(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+}
+
+/**
+ * @brief           申请块数组[容量按每块期望元素数量换算，块数量取2的幂]
+ * @param filter    过滤器
+ * @param capacity  期望容量
+ * @return          false表示失败，否则为成功
+ */
+static bool alloc_blocks(bloom_filter_t *filter, uint64_t capacity) {
+    uint64_t count = 1;
+    while (count * per_block_items < capacity) {
+        count <<= 1;
+    }
+
+    void *memory = mem_calloc(MEM_INDEX, count * block_size + block_size - 1, 1);
+    if (memory == NULL) {
+        LOG_C(LOG_ERROR, "Failed to calloc resources for bloom filter.")
+        return false;
+    }
+    MEM_FREE(MEM_INDEX, filter->memory)
+    filter->memory = memory;
+    filter->blocks = (uint8_t *)(((uintptr_t)memory + block_size - 1) & ~(uintptr_t)(block_size - 1));
+    filter->mask = count - 1;
+    filter->stat.blocks = count;
+    filter->stat.items = 0;
+    return true;
+}
+
+/**
+ * @brief           增减键对应的所有计数器
+ * @param filter    过滤器
+ * @param key       键
+ * @param delta     1表示增加，-1表示减少
+ */
+static void update_counters(bloom_filter_t *filter, uint64_t key, int8_t delta) {
+    uint64_t hash = mix_hash(key);
+    uint8_t *block = filter->blocks + ((hash >> 32) & filter->mask) * block_size;
+    for (uint8_t i = 0; i < hash_count; i++) {
+        uint8_t slot = (hash >> (i * 7)) & 0x7F;
+        uint8_t shift = (slot & 1) << 2;
+        uint8_t counter = (block[slot >> 1] >> shift) & max_counter;
+        if (counter == max_counter || (delta < 0 && counter == 0)) {
+            continue;
+        }
+        counter += delta;
+        block[slot >> 1] = (block[slot >> 1] & ~(max_counter << shift)) | (counter << shift);
+    }
+}
+
+/**
+ * @brief           创建过滤器
+ * @param capacity  期望容量
+ * @return          NULL表示失败，否则为成功
+ */
+bloom_filter_t *create_bloom_filter(uint64_t capacity) {
+    bloom_filter_t *filter = mem_calloc(MEM_INDEX, 1, sizeof(bloom_filter_t));
+    if (filter == NULL) {
+        LOG_C(LOG_ERROR, "Failed to calloc resources for bloom filter.")
+        return NULL;
+    }
+    if (!alloc_blocks(filter, capacity)) {
+        MEM_FREE(MEM_INDEX, filter)
+        return NULL;
+    }
+    return filter;
+}
+
+/**
+ * @brief           删除过滤器
+ * @param filter    过滤器
+ */
+void delete_bloom_filter(bloom_filter_t **filter) {
+    if (filter == NULL || *filter == NULL) {
+        return;
+    }
+    MEM_FREE(MEM_INDEX, (*filter)->memory)
+    MEM_FREE(MEM_INDEX, *filter)
+}
+
+/**
+ * @brief           按新容量清空过滤器[保留查询统计，调用方须重新添加所有键]
+ * @param filter    过滤器
+ * @param capacity  期望容量
+ * @return          false表示失败[原内容保持不变]，否则为成功
+ */
+bool resize_bloom_filter(bloom_filter_t *filter, uint64_t capacity) {
+    if (filter == NULL) {
+        return false;
+    }
+    return alloc_blocks(filter, capacity);
+}
+
+/**
+ * @brief           过滤器元素数量是否达到容量[达到后误判率上升，应扩容]
+ * @param filter    过滤器
+ * @return          true表示已满，否则未满
+ */
+bool is_bloom_filter_full(bloom_filter_t *filter) {
+    return filter != NULL && filter->stat.items >= filter->stat.blocks * per_block_items;
+}
+
+/**
+ * @brief           添加键
+ * @param filter    过滤器
+ * @param key       键
+ */
+void add_key_to_bloom_filter(bloom_filter_t *filter, uint64_t key) {
+    if (filter == NULL) {
+        return;
+    }
+    update_counters(filter, key, 1);
+    filter->stat.items++;
+}
+
+/**
+ * @brief           删除键[须为已添加的键]
+ * @param filter    过滤器
+ * @param key       键
+ */
+void remove_key_from_bloom_filter(bloom_filter_t *filter, uint64_t key) {
+    if (filter == NULL || filter->stat.items == 0) {
+        return;
+    }
+    update_counters(filter, key, -1);
+    filter->stat.items--;
+}
+
+/**
+ * @brief           预取键所在块[批量查询时提前发起访存]
+ * @param filter    过滤器
+ * @param key       键
+ */
+void prefetch_bloom_filter_key(bloom_filter_t *filter, uint64_t key) {
+    if (filter == NULL) {
+        return;
+    }
+    __builtin_prefetch(filter->blocks + ((mix_hash(key) >> 32) & filter->mask) * block_size, 0, 1);
+}
+
+/**
+ * @brief           查询键是否可能存在[仅访问一个缓存行]
+ * @param filter    过滤器
+ * @param key       键
+ * @return          false表示一定不存在，否则可能存在
+ */
+bool is_key_maybe_in_bloom_filter(bloom_filter_t *filter, uint64_t key) {
+    if (filter == NULL) {
+        return true;
+    }
+
+    uint64_t hash = mix_hash(key);
+    const uint8_t *block = filter->blocks + ((hash >> 32) & filter->mask) * block_size;
+    atomic_fetch_add_explicit(&filter->lookups, 1, memory_order_relaxed);
+    for (uint8_t i = 0; i < hash_count; i++) {
+        uint8_t slot = (hash >> (i * 7)) & 0x7F;
+        if (((block[slot >> 1] >> ((slot & 1) << 2)) & max_counter) == 0) {
+            atomic_fetch_add_explicit(&filter->negatives, 1, memory_order_relaxed);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief           记录一次误判[查询判定可能存在但实际不存在]
+ * @param filter    过滤器
+ */
+void mark_bloom_false_positive(bloom_filter_t *filter) {
+    if (filter != NULL) {
+        atomic_fetch_add_explicit(&filter->false_positives, 1, memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief           获取过滤器统计
+ * @param filter    过滤器
+ * @param stat      统计信息
+ */
+void get_bloom_filter_stat(bloom_filter_t *filter, bloom_stat_t *stat) {
+    if (filter == NULL || stat == NULL) {
+        return;
+    }
+    *stat = filter->stat;
+    stat->lookups = atomic_load_explicit(&filter->lookups, memory_order_relaxed);
+    stat->negatives = atomic_load_explicit(&filter->negatives, memory_order_relaxed);
+    stat->false_positives = atomic_load_explicit(&filter->false_positives, memory_order_relaxed);
+}
@@ -0,0 +1,40 @@
+//
+//  bloom_filter.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef bloom_filter_h
+#define bloom_filter_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct bloom_filter bloom_filter_t; // 分块计数布隆过滤器
+
+/**
+ * @brief 过滤器统计
+ */
+typedef struct {
+    uint64_t blocks;            // 块数量[每块一个缓存行]
+    uint64_t items;             // 当前元素数量
+    uint64_t lookups;           // 查询次数
+    uint64_t negatives;         // 判定不存在次数
+    uint64_t false_positives;   // 判定可能存在但实际不存在次数[由调用方确认]
+} bloom_stat_t;
+
+bloom_filter_t *create_bloom_filter(uint64_t capacity);
+void delete_bloom_filter(bloom_filter_t **filter);
+bool resize_bloom_filter(bloom_filter_t *filter, uint64_t capacity);
+bool is_bloom_filter_full(bloom_filter_t *filter);
+void add_key_to_bloom_filter(bloom_filter_t *filter, uint64_t key);
+void remove_key_from_bloom_filter(bloom_filter_t *filter, uint64_t key);
+bool is_key_maybe_in_bloom_filter(bloom_filter_t *filter, uint64_t key);
+void prefetch_bloom_filter_key(bloom_filter_t *filter, uint64_t key);
+void mark_bloom_false_positive(bloom_filter_t *filter);
+void get_bloom_filter_stat(bloom_filter_t *filter, bloom_stat_t *stat);
+
+#endif /* bloom_filter_h */
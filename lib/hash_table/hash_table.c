@@ -37,6 +37,7 @@ struct hash_table {
     clear_value_callback clear_func;    // 值清理接口
     copy_value_callback copy_func;      // 值拷贝接口
     is_value_equal_callback match_func; // 值匹配接口
+    mem_type_t value_type;              // 深拷贝值内存分类
 };
 
 static const uint8_t per_bucket = 4;        // 哈希桶容量
@@ -69,7 +70,7 @@ hash_table_t *create_hash_table(table_init_config_t *config) {
         return NULL;
     }
 
-    hash_table_t *hash_table = calloc(1, sizeof(hash_table_t));
+    hash_table_t *hash_table = mem_calloc(MEM_TABLE, 1, sizeof(hash_table_t));
     if (hash_table == NULL) {
         LOG_C(LOG_ERROR, "Failed to calloc resources for creating hash table.")
         return NULL;
@@ -80,13 +81,14 @@ hash_table_t *create_hash_table(table_init_config_t *config) {
     hash_table->clear_func = config->clear_func;
     hash_table->copy_func = config->copy_func;
     hash_table->match_func = config->match_func;
+    hash_table->value_type = config->value_type;
 
     // 保证桶数量为偶数个
     hash_table->bucket_count = (((config->max_size + per_bucket) / per_bucket) >> 1) << 1;
-    hash_table->buckets = calloc(1, sizeof(hash_bucket_t) * hash_table->bucket_count);
+    hash_table->buckets = mem_calloc(MEM_TABLE, 1, sizeof(hash_bucket_t) * hash_table->bucket_count);
     if (hash_table->buckets == NULL) {
         LOG_C(LOG_ERROR, "Failed to calloc resources for buckets.")
-        FREE(hash_table)
+        MEM_FREE(MEM_TABLE, hash_table)
         return NULL;
     }
     LOG_C(LOG_DEBUG, "Create hash table successfully.")
@@ -112,12 +114,12 @@ void delete_hash_table(hash_table_t **hash_table) {
         while (current_node != NULL) {
             next_node = current_node->next;
             table->clear_func(current_node->value);
-            FREE(current_node)
+            MEM_FREE(MEM_NODE, current_node)
             current_node = next_node;
         }
     }
-    FREE(table->buckets)
-    FREE(table)
+    MEM_FREE(MEM_TABLE, table->buckets)
+    MEM_FREE(MEM_TABLE, table)
     *hash_table = NULL;
     LOG_C(LOG_DEBUG, "Delete hash table successfully.")
 }
@@ -138,7 +140,8 @@ hash_table_t *enlarge_hash_table(hash_table_t *old_table) {
         .value_size = old_table->value_size,
         .clear_func = old_table->clear_func,
         .copy_func = old_table->copy_func,
-        .match_func = old_table->match_func
+        .match_func = old_table->match_func,
+        .value_type = old_table->value_type
     };
     hash_table_t *new_table = create_hash_table(&config);
     if (new_table == NULL) {
@@ -152,13 +155,13 @@ hash_table_t *enlarge_hash_table(hash_table_t *old_table) {
         entry_node_t *next_node = bucket->head;
         while (current_node != NULL) {
             next_node = current_node->next;
-            add_item_to_table(&new_table, current_node->key, current_node->value, false);
-            FREE(current_node)
+            add_unique_item_to_table(&new_table, current_node->key, current_node->value, false);
+            MEM_FREE(MEM_NODE, current_node)
             current_node = next_node;
         }
     }
-    FREE(old_table->buckets)
-    FREE(old_table)
+    MEM_FREE(MEM_TABLE, old_table->buckets)
+    MEM_FREE(MEM_TABLE, old_table)
     LOG_C(LOG_DEBUG, "Enlarge hash table successfully.")
     
     return new_table;
@@ -210,14 +213,29 @@ bool add_item_to_table(hash_table_t **hash_table, uint64_t key, void *value, boo
         return false;
     }
     
-    hash_table_t *table = *hash_table;
-
     // 主键存在则禁止插入
-    if (find_item_from_table(table, key, NULL, NULL)) {
+    if (find_item_from_table(*hash_table, key, NULL, NULL)) {
         LOG_C(LOG_ERROR, "Failed to add the item for already added.");
         return false;
     }
-    
+    return add_unique_item_to_table(hash_table, key, value, is_copy);
+}
+
+/**
+ * @brief               向哈希表添加确定不存在的项[调用方保证主键不存在，跳过重复检查]
+ * @param hash_table    哈希表
+ * @param key           主键
+ * @param value         待添加项值
+ * @param is_copy       是否深拷贝值
+ * @return              false表示失败，否则为成功
+ */
+bool add_unique_item_to_table(hash_table_t **hash_table, uint64_t key, void *value, bool is_copy) {
+    if (hash_table == NULL || *hash_table == NULL || key == 0 || value == NULL) {
+        LOG_C(LOG_ERROR, "Failed to add item for invalid param.");
+        return false;
+    }
+
+    hash_table_t *table = *hash_table;
     // 数量超过阈值则扩容
     if (table->count > table->max_size) {
         table = enlarge_hash_table(table);
@@ -227,33 +245,24 @@ bool add_item_to_table(hash_table_t **hash_table, uint64_t key, void *value, boo
         *hash_table = table;
     }
     
-    entry_node_t *new_node = calloc(1, sizeof(entry_node_t));
+    entry_node_t *new_node = mem_calloc(MEM_NODE, 1, sizeof(entry_node_t));
     if (new_node == NULL) {
         LOG_C(LOG_ERROR, "Failed to calloc resources for new node.");
         return false;
     }
     new_node->key = key;
     if (is_copy) {
-        new_node->value = calloc(1, table->value_size);
+        new_node->value = mem_calloc(table->value_type, 1, table->value_size);
         table->copy_func(new_node->value, value);
     }
     else {
         new_node->value = value;
     }
     
+    // 插入桶头，无需遍历链表
     hash_bucket_t *bucket = &table->buckets[hash_code(new_node->key, table->bucket_count)];
-    // 头结点无值存储至头
-    if (bucket->head == NULL) {
-        bucket->head = new_node;
-    }
-    // 头结点有值存储至尾
-    else {
-        entry_node_t *tail_node = bucket->head;
-        while (tail_node->next != NULL) {
-            tail_node = tail_node->next;
-        }
-        tail_node->next = new_node;
-    }
+    new_node->next = bucket->head;
+    bucket->head = new_node;
     table->count++;
     LOG_C(LOG_DEBUG, "After adding, number of items in hash table is [%llu].", table->count)
     
@@ -291,13 +300,49 @@ bool remove_item_from_table(hash_table_t *hash_table, uint64_t key) {
         last->next = current->next;
     }
     hash_table->clear_func(current->value);
-    FREE(current)
+    MEM_FREE(MEM_NODE, current)
     hash_table->count--;
     LOG_C(LOG_DEBUG, "After removing, number of items in hash table is [%llu].", hash_table->count)
     
     return true;
 }
 
+/**
+ * @brief               单次遍历删除所有匹配项[原地摘除结点，无需逐项按键查找]
+ * @param hash_table    哈希表
+ * @param value         待匹配值[NULL表示通配]
+ * @param func          删除判定回调[NULL表示删除所有匹配项]
+ * @param context       回调上下文
+ * @return              删除项数量
+ */
+uint64_t remove_items_from_table(hash_table_t *hash_table, void *value, remove_item_callback func, void *context) {
+    if (hash_table == NULL) {
+        LOG_C(LOG_ERROR, "Failed to remove items for invalid param.");
+        return 0;
+    }
+
+    uint64_t count = 0;
+    for (uint64_t i = 0; i < hash_table->bucket_count; ++i) {
+        // 以前驱结点的next地址遍历，头结点与中间结点统一摘除
+        entry_node_t **link = &hash_table->buckets[i].head;
+        while (*link != NULL) {
+            entry_node_t *current = *link;
+            if ((value == NULL || hash_table->match_func(value, current->value)) &&
+                (func == NULL || func(current->value, context))) {
+                *link = current->next;
+                hash_table->clear_func(current->value);
+                MEM_FREE(MEM_NODE, current)
+                hash_table->count--;
+                count++;
+                continue;
+            }
+            link = &current->next;
+        }
+    }
+    LOG_C(LOG_DEBUG, "After removing [%llu] items, number of items in hash table is [%llu].", count, hash_table->count)
+    return count;
+}
+
 /**
  * @brief               从哈希表更新指定项
  * @param hash_table    哈希表
@@ -320,6 +365,33 @@ bool modify_item_from_table(hash_table_t *hash_table, uint64_t key, void *value)
     return true;
 }
 
+/**
+ * @brief               预取主键所在桶[批量查找时提前发起访存]
+ * @param hash_table    哈希表
+ * @param key           主键
+ */
+void prefetch_bucket_by_key(hash_table_t *hash_table, uint64_t key) {
+    if (hash_table == NULL) {
+        return;
+    }
+    __builtin_prefetch(&hash_table->buckets[hash_code(key, hash_table->bucket_count)], 0, 1);
+}
+
+/**
+ * @brief               预取主键所在桶的首结点[须在桶预取完成后调用，否则读取桶时阻塞]
+ * @param hash_table    哈希表
+ * @param key           主键
+ */
+void prefetch_node_by_key(hash_table_t *hash_table, uint64_t key) {
+    if (hash_table == NULL) {
+        return;
+    }
+    entry_node_t *head = hash_table->buckets[hash_code(key, hash_table->bucket_count)].head;
+    if (head != NULL) {
+        __builtin_prefetch(head, 0, 1);
+    }
+}
+
 /**
  * @brief               从哈希表获取指定项[关键字工号]
  * @param hash_table    哈希表
@@ -345,25 +417,59 @@ void *get_item_by_key(hash_table_t *hash_table, uint64_t key) {
  * @param hash_table    哈希表
  * @param value         待匹配项[NULL表示通配]
  * @param count         匹配成功项个数地址
- * @return              匹配成功项信息[动态申请内存，需调用方释放]
+ * @return              匹配成功项信息[动态申请内存，需调用方按MEM_RESULT分类释放]
  */
 void **get_items_by_value(hash_table_t *hash_table, void *value, uint64_t *count) {
     if (hash_table == NULL || count == NULL) {
         return NULL;
     }
-    
+    return get_items_by_value_in_range(hash_table, value, 0, hash_table->bucket_count, count);
+}
+
+/**
+ * @brief               获取指定桶区间内值匹配的所有项[不同区间可由多个线程并行获取]
+ * @param hash_table    哈希表
+ * @param value         待匹配值[NULL表示通配]
+ * @param begin         起始桶序号
+ * @param end           结束桶序号[不含]
+ * @param count         匹配项数量
+ * @return              匹配项数组[动态申请内存，需调用方按MEM_RESULT分类释放]
+ */
+void **get_items_by_value_in_range(hash_table_t *hash_table, void *value, uint64_t begin, uint64_t end, uint64_t *count) {
+    if (hash_table == NULL || count == NULL) {
+        return NULL;
+    }
+
     *count = 0;
-    void **info = calloc(1, sizeof(void *)*hash_table->count);
+    end = end < hash_table->bucket_count ? end : hash_table->bucket_count;
+    begin = begin < end ? begin : end;
+    // 全表按元素数量申请，区间按桶占比预估，不足时倍增
+    uint64_t capacity = hash_table->count;
+    if (end - begin < hash_table->bucket_count) {
+        capacity = hash_table->count * (end - begin) / hash_table->bucket_count + per_bucket;
+    }
+    capacity = capacity > 0 ? capacity : 1;
+    void **info = mem_calloc(MEM_RESULT, capacity, sizeof(void *));
     if (info == NULL) {
         return NULL;
     }
 
     // 遍历输出所有匹配项，无序输出
-    for (uint64_t i = 0; i < hash_table->bucket_count; ++i) {
+    for (uint64_t i = begin; i < end; ++i) {
         hash_bucket_t *bucket = &hash_table->buckets[i];
         entry_node_t *current_node = bucket->head;
         while (current_node != NULL) {
             if (value == NULL || hash_table->match_func(value, current_node->value)) {
+                if (*count == capacity) {
+                    void **temp = mem_realloc(MEM_RESULT, info, sizeof(void *) * capacity * 2);
+                    if (temp == NULL) {
+                        MEM_FREE(MEM_RESULT, info)
+                        *count = 0;
+                        return NULL;
+                    }
+                    info = temp;
+                    capacity *= 2;
+                }
                 info[*count] = current_node->value;
                 (*count)++;
             }
@@ -377,6 +483,43 @@ void **get_items_by_value(hash_table_t *hash_table, void *value, uint64_t *count
     return info;
 }
 
+/**
+ * @brief               获取哈希表桶数量
+ * @param hash_table    哈希表
+ * @return              桶数量
+ */
+uint64_t get_bucket_count_from_table(hash_table_t *hash_table) {
+    return hash_table != NULL ? hash_table->bucket_count : 0;
+}
+
+/**
+ * @brief               遍历哈希表中匹配指定信息的项[不申请额外内存]
+ * @param hash_table    哈希表
+ * @param value         待匹配项[NULL表示通配]
+ * @param func          匹配项回调
+ * @param context       回调上下文
+ * @return              false表示失败或遍历被终止，否则为成功
+ */
+bool traverse_items_from_table(hash_table_t *hash_table, void *value, traverse_item_callback func, void *context) {
+    if (hash_table == NULL || func == NULL) {
+        LOG_C(LOG_ERROR, "Failed to traverse items for invalid param.");
+        return false;
+    }
+
+    for (uint64_t i = 0; i < hash_table->bucket_count; ++i) {
+        entry_node_t *current_node = hash_table->buckets[i].head;
+        while (current_node != NULL) {
+            if (value == NULL || hash_table->match_func(value, current_node->value)) {
+                if (!func(current_node->value, context)) {
+                    return false;
+                }
+            }
+            current_node = current_node->next;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief               获取哈希表元素数量
  * @param hash_table    哈希表
@@ -12,6 +12,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include "mem_stat.h"
 
 #define FREE(ptr)   if (ptr != NULL) {free(ptr); ptr = NULL;}
 
@@ -19,6 +20,8 @@ typedef struct hash_table hash_table_t; // 哈希表
 typedef void(*clear_value_callback)(void *value);                           // 值清理回调
 typedef void(*copy_value_callback)(void *dst, const void *src);             // 值拷贝回调
 typedef bool(*is_value_equal_callback)(const void *src, const void *dst);   // 值匹配回调
+typedef bool(*traverse_item_callback)(void *value, void *context);          // 遍历回调[返回false终止遍历]
+typedef bool(*remove_item_callback)(void *value, void *context);            // 删除判定回调[返回true删除该项，回调时值尚未清理]
 
 /**
  * @brief 哈希表初始化
@@ -29,6 +32,7 @@ typedef struct {
     clear_value_callback clear_func;    // 值清理函数
     copy_value_callback copy_func;      // 值拷贝函数
     is_value_equal_callback match_func; // 值比较函数
+    mem_type_t value_type;              // 深拷贝值内存分类[用于内存统计，值清理函数须按该分类释放]
 } table_init_config_t;
 
 hash_table_t *create_hash_table(table_init_config_t *config);
@@ -36,10 +40,17 @@ void delete_hash_table(hash_table_t **hash_table);
 hash_table_t *enlarge_hash_table(hash_table_t *old_table);
 
 bool add_item_to_table(hash_table_t **hash_table, uint64_t key, void *value, bool is_copy);
+bool add_unique_item_to_table(hash_table_t **hash_table, uint64_t key, void *value, bool is_copy);
 bool remove_item_from_table(hash_table_t *hash_table, uint64_t key);
+uint64_t remove_items_from_table(hash_table_t *hash_table, void *value, remove_item_callback func, void *context);
 bool modify_item_from_table(hash_table_t *hash_table, uint64_t key, void *value);
 void *get_item_by_key(hash_table_t *hash_table, uint64_t key);
+void prefetch_bucket_by_key(hash_table_t *hash_table, uint64_t key);
+void prefetch_node_by_key(hash_table_t *hash_table, uint64_t key);
 void **get_items_by_value(hash_table_t *hash_table, void *value, uint64_t *count);
+void **get_items_by_value_in_range(hash_table_t *hash_table, void *value, uint64_t begin, uint64_t end, uint64_t *count);
+uint64_t get_bucket_count_from_table(hash_table_t *hash_table);
+bool traverse_items_from_table(hash_table_t *hash_table, void *value, traverse_item_callback func, void *context);
 uint64_t get_count_from_table(hash_table_t *hash_table);
 
 #endif /* hash_table_h */
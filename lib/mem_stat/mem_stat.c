@@ -0,0 +1,156 @@
+//
+//  mem_stat.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "mem_stat.h"
+#include "common.h"
+#include <string.h>
+#include <stdatomic.h>
+#ifdef __APPLE__
+#include <malloc/malloc.h>
+#define get_block_size(ptr)     malloc_size(ptr)
+#else
+#include <malloc.h>
+#define get_block_size(ptr)     malloc_usable_size(ptr)
+#endif
+
+/**
+ * @brief 内存计数[MEM_MAX项为合计]
+ */
+typedef struct {
+    atomic_uint_fast64_t current;   // 当前字节数
+    atomic_uint_fast64_t peak;      // 峰值字节数
+    atomic_uint_fast64_t blocks;    // 当前内存块数量
+} mem_counter_t;
+
+static mem_counter_t s_counters[MEM_MAX + 1];   // 各分类内存计数[按实际占用字节统计，含分配器对齐]
+
+/**
+ * @brief           增加计数并更新峰值
+ * @param counter   内存计数
+ * @param size      字节数
+ */
+static void increase_counter(mem_counter_t *counter, uint64_t size) {
+    uint64_t current = atomic_fetch_add(&counter->current, size) + size;
+    update_atomic_maximum(&counter->peak, current);
+    atomic_fetch_add(&counter->blocks, 1);
+}
+
+/**
+ * @brief           减少计数
+ * @param counter   内存计数
+ * @param size      字节数
+ */
+static void decrease_counter(mem_counter_t *counter, uint64_t size) {
+    atomic_fetch_sub(&counter->current, size);
+    atomic_fetch_sub(&counter->blocks, 1);
+}
+
+/**
+ * @brief       记录内存申请
+ * @param type  内存分类
+ * @param ptr   内存地址[NULL时忽略]
+ */
+static void account_alloc(mem_type_t type, void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    uint64_t size = get_block_size(ptr);
+    type = type < MEM_MAX ? type : MEM_OTHER;
+    increase_counter(&s_counters[type], size);
+    increase_counter(&s_counters[MEM_MAX], size);
+}
+
+/**
+ * @brief       记录内存释放
+ * @param type  内存分类
+ * @param ptr   内存地址[NULL时忽略]
+ */
+static void account_free(mem_type_t type, void *ptr) {
+    if (ptr == NULL) {
+        return;
+    }
+    uint64_t size = get_block_size(ptr);
+    type = type < MEM_MAX ? type : MEM_OTHER;
+    decrease_counter(&s_counters[type], size);
+    decrease_counter(&s_counters[MEM_MAX], size);
+}
+
+/**
+ * @brief       申请内存并计入分类
+ * @param type  内存分类
+ * @param size  字节数
+ * @return      NULL表示失败，否则为成功
+ */
+void *mem_malloc(mem_type_t type, size_t size) {
+    void *ptr = malloc(size);
+    account_alloc(type, ptr);
+    return ptr;
+}
+
+/**
+ * @brief       申请置零内存并计入分类
+ * @param type  内存分类
+ * @param count 元素数量
+ * @param size  元素大小
+ * @return      NULL表示失败，否则为成功
+ */
+void *mem_calloc(mem_type_t type, size_t count, size_t size) {
+    void *ptr = calloc(count, size);
+    account_alloc(type, ptr);
+    return ptr;
+}
+
+/**
+ * @brief       重新申请内存并计入分类[失败时原内存保持不变]
+ * @param type  内存分类
+ * @param ptr   原内存地址
+ * @param size  字节数
+ * @return      NULL表示失败，否则为成功
+ */
+void *mem_realloc(mem_type_t type, void *ptr, size_t size) {
+    account_free(type, ptr);
+    void *new_ptr = realloc(ptr, size);
+    account_alloc(type, new_ptr != NULL ? new_ptr : ptr);
+    return new_ptr;
+}
+
+/**
+ * @brief           拷贝字符串并计入分类
+ * @param type      内存分类
+ * @param string    待拷贝字符串
+ * @param size      最多拷贝字节数
+ * @return          NULL表示失败，否则为成功
+ */
+char *mem_strndup(mem_type_t type, const char *string, size_t size) {
+    char *ptr = strndup(string, size);
+    account_alloc(type, ptr);
+    return ptr;
+}
+
+/**
+ * @brief       释放内存并从分类中扣除[须与申请时分类一致]
+ * @param type  内存分类
+ * @param ptr   内存地址
+ */
+void mem_free(mem_type_t type, void *ptr) {
+    account_free(type, ptr);
+    free(ptr);
+}
+
+/**
+ * @brief       获取内存统计
+ * @param type  内存分类[MEM_MAX表示合计]
+ * @param stat  统计信息
+ */
+void get_mem_stat(mem_type_t type, mem_stat_t *stat) {
+    if (stat == NULL || type > MEM_MAX) {
+        return;
+    }
+    stat->current = atomic_load(&s_counters[type].current);
+    stat->peak = atomic_load(&s_counters[type].peak);
+    stat->blocks = atomic_load(&s_counters[type].blocks);
+}
@@ -0,0 +1,48 @@
+//
+//  mem_stat.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef mem_stat_h
+#define mem_stat_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#define MEM_FREE(type, ptr)   if (ptr != NULL) {mem_free(type, ptr); ptr = NULL;}
+
+/**
+ * @brief 内存分类
+ */
+typedef enum {
+    MEM_OTHER,      // 其他
+    MEM_TABLE,      // 哈希表及哈希桶
+    MEM_NODE,       // 哈希表结点
+    MEM_RECORD,     // 员工记录[含内联字符串]
+    MEM_STRING,     // 独立字符串
+    MEM_INDEX,      // 索引及分组计数
+    MEM_RESULT,     // 查询临时数组
+    MEM_MAX
+} mem_type_t;
+
+/**
+ * @brief 内存统计
+ */
+typedef struct {
+    uint64_t current;   // 当前字节数
+    uint64_t peak;      // 峰值字节数
+    uint64_t blocks;    // 当前内存块数量
+} mem_stat_t;
+
+void *mem_malloc(mem_type_t type, size_t size);
+void *mem_calloc(mem_type_t type, size_t count, size_t size);
+void *mem_realloc(mem_type_t type, void *ptr, size_t size);
+char *mem_strndup(mem_type_t type, const char *string, size_t size);
+void mem_free(mem_type_t type, void *ptr);
+void get_mem_stat(mem_type_t type, mem_stat_t *stat);
+
+#endif /* mem_stat_h */
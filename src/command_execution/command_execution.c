@@ -8,86 +8,254 @@
 #include "command_execution.h"
 #include "database_manager.h"
 #include "manager_server.h"
+#include "data_export.h"
+#include "query_cache.h"
+#include "staff_sort.h"
+#include "replication.h"
+#include "request_queue.h"
+#include "text_format.h"
 #include "log.h"
+#include "mem_stat.h"
 #include <time.h>
+#include <fcntl.h>
 #include <string.h>
+#include <stdarg.h>
+#include <sched.h>
+#include <pthread.h>
 #include <stdatomic.h>
 
-atomic_int active_request = 0;          // 活跃事件数量
+/**
+ * @brief 批处理撤销记录
+ */
+typedef struct {
+    uint64_t staff_id;      // 工号
+    staff_info_t *origin;   // 执行前员工信息[NULL表示执行前不存在]
+} batch_undo_t;
+
+/**
+ * @brief 执行权计数[各模式分别统计]
+ */
+typedef struct {
+    atomic_uint_fast64_t acquisitions;  // 获取次数
+    atomic_uint_fast64_t contentions;   // 需等待的获取次数
+    atomic_uint_fast64_t wait_ns;       // 累计等待时长[纳秒]
+    atomic_uint_fast64_t max_wait_ns;   // 最长等待时长[纳秒]
+} gate_counter_t;
+
+/**
+ * @brief 扫描时间片[低优先级扫描每个时间片结束时让出处理器，有独占执行权等待时同时让出执行权]
+ */
+typedef struct {
+    uint64_t deadline;  // 当前时间片截止时刻[单调时钟纳秒]
+    uint64_t version;   // 持有执行权期间的数据版本
+    uint32_t steps;     // 距上次检查时钟的处理项数
+    uint8_t restarts;   // 因数据变更重启次数
+    bool is_yieldable;  // 是否允许让出[仅低优先级扫描，重启次数达上限后不再让出以保证完成]
+    bool is_stale;      // 让出期间数据已变更[已取得的员工指针失效，扫描须重启]
+} scan_slice_t;
+
+/**
+ * @brief 选择器遍历上下文
+ */
+typedef struct {
+    staff_selector_t *selector; // 员工选择器
+    scan_slice_t *slice;        // 扫描时间片
+} slice_select_t;
+
+/**
+ * @brief 批处理
+ */
+typedef struct {
+    query_info_t *queries;  // 已解析的增删改指令
+    uint32_t count;         // 指令数量
+    uint32_t capacity;      // 指令数组容量
+    bool is_failed;         // 批内存在解析失败或不支持的指令
+} command_batch_t;
+
+static const uint8_t max_staff_text_size = 128;    // 单条员工信息除姓名、部门、职位外的最大长度
+static const char staff_id_label[] = "staff id: ";  // 员工信息各字段标签
+static const char name_label[] = ", name: ";
+static const char date_label[] = ", date: ";
+static const char dept_label[] = ", department: ";
+static const char pos_label[] = ", position: ";
+static const char staff_end_label[] = ".\n";
+static const char null_label[] = "(null)";          // 空字段输出
+static const uint64_t scan_slice_ns = 500000;       // 扫描时间片长度[纳秒]
+static const uint16_t slice_check_steps = 256;      // 每处理若干项检查一次时钟
+static const uint8_t max_scan_restarts = 3;         // 扫描因数据变更重启次数上限
+static const uint8_t max_high_priority_ids = 64;    // 高优先级多工号查询的工号数量上限
+
+static pthread_rwlock_t s_command_gate;             // 指令执行权[只读指令共享，变更指令独占]
+static gate_counter_t s_gate_counters[GATE_MAX];    // 执行权计数
+static atomic_uint s_exclusive_waiters = 0;         // 等待独占执行权的线程数量
+static atomic_uint_fast64_t s_slice_yields = 0;     // 扫描让出执行权次数
+static atomic_uint_fast64_t s_slice_restarts = 0;   // 扫描因数据变更重启次数
 command_info_t g_cmd_infos[CMD_MAX];    // 指令操作信息
+static command_batch_t *s_batches[UINT8_MAX + 1] = {NULL};  // 各输入描述符进行中的批处理
 
 /**
- * @brief           比较员工工号
- * @param staff1    员工1
- * @param staff2    员工2
- * @return          比较结果
+* @brief 内存分类描述
+*/
+static const char *mem_type_str[] = {
+    [MEM_OTHER]     = "other",
+    [MEM_TABLE]     = "table",
+    [MEM_NODE]      = "node",
+    [MEM_RECORD]    = "record",
+    [MEM_STRING]    = "string",
+    [MEM_INDEX]     = "index",
+    [MEM_RESULT]    = "result",
+    [MEM_MAX]       = "total",
+};
+
+/**
+* @brief 执行权模式描述
+*/
+static const char *gate_mode_str[] = {
+    [GATE_SHARED]       = "shared",
+    [GATE_EXCLUSIVE]    = "exclusive",
+};
+
+/**
+* @brief 请求优先级描述
+*/
+static const char *priority_str[] = {
+    [PRIORITY_HIGH] = "high",
+    [PRIORITY_LOW]  = "low",
+};
+
+/**
+* @brief 复制角色描述
+*/
+static const char *repl_role_str[] = {
+    [REPL_NONE]     = "none",
+    [REPL_PRIMARY]  = "primary",
+    [REPL_FOLLOWER] = "follower",
+};
+
+/**
+ * @brief           开始扫描时间片
+ * @param slice     扫描时间片
+ * @param query     查询信息
  */
-STATIC int compare_staff_id(const void *staff1, const void *staff2) {
-    staff_info_t *info1 = *(staff_info_t **)staff1;
-    staff_info_t *info2 = *(staff_info_t **)staff2;
-    return (int)(info1->staff_id - info2->staff_id);
+static void begin_scan_slice(scan_slice_t *slice, const query_info_t *query) {
+    slice->is_yieldable = query->priority == PRIORITY_LOW && slice->restarts < max_scan_restarts;
+    slice->is_stale = false;
+    slice->steps = 0;
+    slice->version = get_database_version();
+    slice->deadline = get_monotonic_ns() + scan_slice_ns;
 }
 
 /**
- * @brief           比较员工入职日期
- * @param staff1    员工1
- * @param staff2    员工2
- * @return          比较结果
+ * @brief           扫描步进[须持有共享执行权，时间片用尽时让出处理器，有独占执行权等待时释放后重新获取]
+ * @param slice     扫描时间片[NULL表示不分时间片]
+ * @return          false表示让出期间数据已变更，已取得的员工指针失效，扫描须重启
  */
-STATIC int compare_staff_date(const void *staff1, const void *staff2) {
-    staff_info_t *info1 = *(staff_info_t **)staff1;
-    staff_info_t *info2 = *(staff_info_t **)staff2;
-    return (int)(info1->date - info2->date);
+STATIC bool step_scan_slice(scan_slice_t *slice) {
+    if (slice == NULL || !slice->is_yieldable || ++slice->steps < slice_check_steps) {
+        return true;
+    }
+
+    slice->steps = 0;
+    if (get_monotonic_ns() < slice->deadline) {
+        return true;
+    }
+    if (atomic_load(&s_exclusive_waiters) > 0) {
+        release_command_gate();
+        sched_yield();
+        acquire_command_gate(GATE_SHARED);
+        atomic_fetch_add(&s_slice_yields, 1);
+        if (get_database_version() != slice->version) {
+            slice->is_stale = true;
+            return false;
+        }
+    }
+    else {
+        sched_yield();
+    }
+    slice->deadline = get_monotonic_ns() + scan_slice_ns;
+    return true;
+}
+
+/**
+ * @brief           按时间片选择员工[数据库遍历回调]
+ * @param info      员工信息
+ * @param context   选择器遍历上下文
+ * @return          false表示终止遍历，否则为继续
+ */
+static bool select_a_sliced_staff(const staff_info_t *info, void *context) {
+    slice_select_t *select = (slice_select_t *)context;
+    return step_scan_slice(select->slice) && select_a_staff(info, select->selector);
 }
 
 /**
- * @brief           打印指定员工信息
+ * @brief           复制文本至写入位置
+ * @param cursor    写入位置
+ * @param text      文本
+ * @param length    文本长度
+ * @return          写入后的位置
+ */
+static inline char *copy_text(char *cursor, const char *text, size_t length) {
+    memcpy(cursor, text, length);
+    return cursor + length;
+}
+
+/**
+ * @brief           追加指定员工信息至请求结果[预留整行空间后直接写入，不经过格式化解析]
  * @param value     员工信息
- * @param output    缓存数组
- * @param size      缓存大小
+ * @param request   原始请求
  */
-STATIC void print_a_staff_info(const staff_info_t *value, char *output, size_t size) {
-    if (value == NULL || output == NULL || size == 0) {
+STATIC void print_a_staff_info(const staff_info_t *value, user_request_t *request) {
+    if (value == NULL || request == NULL) {
+        return;
+    }
+
+    const char *name = value->name != NULL ? value->name : null_label;
+    const char *department = value->department != NULL ? value->department : null_label;
+    const char *position = value->position != NULL ? value->position : null_label;
+    size_t name_len = strlen(name);
+    size_t dept_len = strlen(department);
+    size_t pos_len = strlen(position);
+    char *cursor = reserve_request_result(request, max_staff_text_size + name_len + dept_len + pos_len);
+    if (cursor == NULL) {
         return;
     }
 
-    char time_str[time_str_size] = {"\0"};
-    strftime(time_str, time_str_size, "%Y-%m-%d %H:%M:%S", localtime((time_t *)&value->date));
-    snprintf(output, size, "staff id: %llu, name: %s, date: %s, department: %s, position: %s.\n", \
-    value->staff_id, value->name, time_str, value->department, value->position);
+    char *begin = cursor;
+    cursor = copy_text(cursor, staff_id_label, sizeof(staff_id_label) - 1);
+    cursor += format_uint64(cursor, value->staff_id);
+    cursor = copy_text(cursor, name_label, sizeof(name_label) - 1);
+    cursor = copy_text(cursor, name, name_len);
+    cursor = copy_text(cursor, date_label, sizeof(date_label) - 1);
+    cursor += format_date_time(cursor, value->date);
+    cursor = copy_text(cursor, dept_label, sizeof(dept_label) - 1);
+    cursor = copy_text(cursor, department, dept_len);
+    cursor = copy_text(cursor, pos_label, sizeof(pos_label) - 1);
+    cursor = copy_text(cursor, position, pos_len);
+    cursor = copy_text(cursor, staff_end_label, sizeof(staff_end_label) - 1);
+    commit_request_result(request, cursor - begin);
 }
 
 /**
- * @brief           打印所有员工信息
+ * @brief           打印所有员工信息[按数组顺序，结果不截断]
  * @param values    员工信息数组
  * @param count     数组大小
- * @param output    缓存数组
+ * @param request   原始请求
+ * @param slice     扫描时间片[NULL表示不分时间片]
+ * @return          false表示让出执行权期间数据已变更，否则为成功
  */
-STATIC void print_staffs_info(staff_info_t **values, uint64_t count, sort_type_t type, char *output) {
+STATIC bool print_staffs_info(staff_info_t **values, uint64_t count, user_request_t *request, scan_slice_t *slice) {
     if (values == NULL) {
-        return;
-    }
-    size_t rest = 0;
-    size_t len = 0;
-    LOG_C(LOG_DEBUG, "Total [%llu] staffs meet the criteria.", count)
-
-    switch (type) {
-        case SORT_ID:
-            qsort(values, count, sizeof(staff_info_t *), compare_staff_id);
-            break;
-        case SORT_DATE:
-            qsort(values, count, sizeof(staff_info_t *), compare_staff_date);
-            break;
-
-        default:
-            break;
+        return true;
     }
+    LOG_C(LOG_DEBUG, "Total [%llu] staffs will be printed.", count)
 
     for (uint64_t i = 0; i < count; i++) {
-        len = strlen(output);
-        rest = BUFSIZ - len;
-        print_a_staff_info(values[i], output+len, rest);
+        if (!step_scan_slice(slice)) {
+            return false;
+        }
+        print_a_staff_info(values[i], request);
     }
+    return true;
 }
 
 /**
@@ -97,12 +265,42 @@ STATIC void print_staffs_info(staff_info_t **values, uint64_t count, sort_type_t
  */
 STATIC void add_employee(query_info_t *query, user_request_t *request) {
     if (add_item_to_database(&query->info)) {
+        publish_replication(REPL_OP_ADD, &query->info);
         request->is_success = true;
-        snprintf(request->result, BUFSIZ, "The staff [%llu] is added.", query->info.staff_id);
+        set_request_result(request, "The staff [%llu] is added.", query->info.staff_id);
     }
     else {
         request->is_success = false;
-        snprintf(request->result, BUFSIZ, "Failed to add the staff [%llu].", query->info.staff_id);
+        set_request_result(request, "Failed to add the staff [%llu].", query->info.staff_id);
+    }
+}
+
+/**
+ * @brief           推送已删除员工[批量删除回调]
+ * @param info      员工信息
+ * @param context   回调上下文[未使用]
+ * @return          true表示继续
+ */
+static bool publish_removed_staff(const staff_info_t *info, void *context) {
+    publish_replication(REPL_OP_DEL, info);
+    return true;
+}
+
+/**
+ * @brief           按部门、职位、姓名及入职日期批量删除员工[单次遍历，试运行时仅统计数量]
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void remove_filtered_employees(query_info_t *query, user_request_t *request) {
+    staff_info_t *filter = query->is_opt_all ? NULL : &query->info;
+    uint64_t count = remove_items_by_filter_from_database(filter, query->date_from, query->date_to, query->is_dry_run,
+        publish_removed_staff, NULL);
+    request->is_success = true;
+    if (query->is_dry_run) {
+        set_request_result(request, "[%llu] staffs would be removed.", count);
+    }
+    else {
+        set_request_result(request, "[%llu] staffs are removed.", count);
     }
 }
 
@@ -112,20 +310,30 @@ STATIC void add_employee(query_info_t *query, user_request_t *request) {
  * @param request   原始请求
  */
 STATIC void del_employee(query_info_t *query, user_request_t *request) {
-    if (query->is_opt_all) {
+    if (query->is_opt_all && !query->is_dry_run) {
         delete_database();
         create_database();
+        publish_replication(REPL_OP_CLEAR, NULL);
         request->is_success = true;
-        snprintf(request->result, BUFSIZ, "All staffs are removed.");
+        set_request_result(request, "All staffs are removed.");
+    }
+    else if (query->is_opt_all || query->info.staff_id == 0) {
+        remove_filtered_employees(query, request);
+    }
+    else if (query->is_dry_run) {
+        request->is_success = true;
+        uint64_t count = get_by_id_from_database(query->info.staff_id) != NULL ? 1 : 0;
+        set_request_result(request, "[%llu] staffs would be removed.", count);
     }
     else {
         if (remove_item_from_database(query->info.staff_id)) {
+            publish_replication(REPL_OP_DEL, &query->info);
             request->is_success = true;
-            snprintf(request->result, BUFSIZ, "The staff [%llu] is removed.", query->info.staff_id);
+            set_request_result(request, "The staff [%llu] is removed.", query->info.staff_id);
         }
         else {
             request->is_success = false;
-            snprintf(request->result, BUFSIZ, "Failed to remove the staff [%llu].", query->info.staff_id);
+            set_request_result(request, "Failed to remove the staff [%llu].", query->info.staff_id);
         }
     }
 }
@@ -136,45 +344,531 @@ STATIC void del_employee(query_info_t *query, user_request_t *request) {
  * @param request   原始请求
  */
 STATIC void mod_employee(query_info_t *query, user_request_t *request) {
-    if (modify_item_from_database(&query->info)) {
+    uint8_t changed = MODIFY_NONE;
+    // 解析所得字符串按需转移至员工记录，避免重复拷贝
+    if (modify_item_from_database(&query->info, true, &changed)) {
         request->is_success = true;
-        snprintf(request->result, BUFSIZ, "Info of the staff [%llu] is modified.", query->info.staff_id);
+        if (changed == MODIFY_NONE) {
+            set_request_result(request, "Info of the staff [%llu] is unchanged.", query->info.staff_id);
+            return;
+        }
+        // 推送修改后的完整信息，跟随者无需合并字段
+        publish_replication(REPL_OP_MOD, get_by_id_from_database(query->info.staff_id));
+        set_request_result(request, "Info of the staff [%llu] is modified.", query->info.staff_id);
     }
     else {
         request->is_success = false;
-        snprintf(request->result, BUFSIZ, "Failed to modify info of the staff [%llu].", query->info.staff_id);
+        set_request_result(request, "Failed to modify info of the staff [%llu].", query->info.staff_id);
     }
 }
 
+/**
+ * @brief           批量获取多个工号的员工信息[按请求顺序合并输出，其余过滤信息忽略]
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void get_employees_by_ids(query_info_t *query, user_request_t *request) {
+    staff_info_t **staff_infos = mem_calloc(MEM_RESULT, query->id_count, sizeof(staff_info_t *));
+    if (staff_infos == NULL) {
+        request->is_success = false;
+        set_request_result(request, "Failed to get staffs for no memory.");
+        return;
+    }
+
+    get_by_ids_from_database(query->staff_ids, query->id_count, staff_infos);
+    uint64_t count = 0;
+    for (uint64_t i = 0; i < query->id_count; i++) {
+        if (staff_infos[i] != NULL) {
+            staff_infos[count++] = staff_infos[i];
+        }
+    }
+    if (count == 0) {
+        set_request_result(request, "No items are found.");
+    }
+    else {
+        print_staffs_info(staff_infos, count, request, NULL);
+        if (count < query->id_count) {
+            append_request_result(request, "[%llu] of [%llu] staffs are not found.\n", query->id_count-count, query->id_count);
+        }
+    }
+    MEM_FREE(MEM_RESULT, staff_infos)
+    request->is_success = true;
+}
+
+/**
+ * @brief           按条件获取员工信息[低优先级查询的遍历及输出分时间片执行]
+ * @param query     查询信息
+ * @param request   原始请求
+ * @param slice     扫描时间片
+ * @return          false表示让出执行权期间数据已变更，须清空结果后重新查询
+ */
+STATIC bool get_filtered_employees(query_info_t *query, user_request_t *request, scan_slice_t *slice) {
+    uint64_t count = 0;
+    staff_info_t **staff_infos = NULL;
+    staff_selector_t selector = {0};
+    sort_order_t no_order = {0};
+    uint64_t capacity = query->offset + query->limit;
+    uint64_t total = get_count_from_database();
+    capacity = (query->limit == 0 || capacity < query->limit || capacity > total) ? total : capacity;
+    // 限制数量时遍历选择前[offset+limit]项，复杂度O(NlogK)；分时间片时逐项遍历收集后全量基数排序；否则并行扫描各分片
+    if ((query->limit != 0 || slice->is_yieldable) &&
+        init_staff_selector(&selector, capacity, query->limit != 0 ? &query->sort_order : &no_order)) {
+        slice_select_t select = {
+            .selector = &selector,
+            .slice = slice
+        };
+        traverse_by_name_pattern_from_database(&query->info, query->name_match, query->max_distance,
+            select_a_sliced_staff, &select);
+        if (slice->is_stale) {
+            free_staff_selector(&selector);
+            return false;
+        }
+        staff_infos = selector.values;
+        count = selector.count;
+        if (query->limit != 0) {
+            finish_staff_selector(&selector);
+        }
+        else {
+            sort_staffs(staff_infos, count, &query->sort_order);
+        }
+    }
+    else {
+        staff_infos = get_by_name_pattern_from_database(&query->info, query->name_match, query->max_distance, &count);
+        sort_staffs(staff_infos, count, &query->sort_order);
+    }
+
+    bool is_done = true;
+    if (count <= query->offset) {
+        set_request_result(request, "No items are found.");
+    }
+    else {
+        is_done = print_staffs_info(staff_infos + query->offset, count - query->offset, request, slice);
+    }
+    MEM_FREE(MEM_RESULT, staff_infos)
+    if (is_done) {
+        put_query_cache(query, get_request_result(request));
+    }
+    return is_done;
+}
+
 /**
  * @brief           获取员工信息
  * @param query     查询信息
  * @param request   原始请求
  */
 STATIC void get_employee(query_info_t *query, user_request_t *request) {
+    if (query->id_count > 0) {
+        get_employees_by_ids(query, request);
+        return;
+    }
     if (query->is_opt_all || query->info.staff_id == 0) {
-        uint64_t count = 0;
-        staff_info_t **staff_infos = get_by_info_from_database(&query->info, &count);
-        if (count == 0) {
-            snprintf(request->result, BUFSIZ, "No items are found.");
+        // 过滤查询优先使用缓存结果[数据变更后缓存自动失效]
+        if (get_query_cache(query, request)) {
+            request->is_success = true;
+            return;
         }
-        else {
-            print_staffs_info(staff_infos, count, query->sort_type, request->result);
+        scan_slice_t slice = {0};
+        begin_scan_slice(&slice, query);
+        while (!get_filtered_employees(query, request, &slice)) {
+            clear_request_result(request);
+            slice.restarts++;
+            atomic_fetch_add(&s_slice_restarts, 1);
+            begin_scan_slice(&slice, query);
         }
-        FREE(staff_infos)
     }
     else {
+        // 热点记录优先使用缓存的渲染结果[修改或删除后失效]
+        if (get_record_cache(query->info.staff_id, request)) {
+            request->is_success = true;
+            return;
+        }
         staff_info_t *staff_info = get_by_id_from_database(query->info.staff_id);
         if (staff_info == NULL) {
-            snprintf(request->result, BUFSIZ, "Staff with id [%llu] is not found.", query->info.staff_id);
+            set_request_result(request, "Staff with id [%llu] is not found.", query->info.staff_id);
         }
         else {
-            print_a_staff_info(staff_info, request->result, BUFSIZ);
+            print_a_staff_info(staff_info, request);
+            put_record_cache(query->info.staff_id, get_request_result(request));
         }
     }
     request->is_success = true;
 }
 
+/**
+ * @brief           导出员工信息[分块写出至文件或请求方，不缓存完整结果]
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void export_employee(query_info_t *query, user_request_t *request) {
+    int output_fd = request->input_fd == STDIN_FILENO ? STDOUT_FILENO : request->input_fd;
+    if (query->export_path != NULL) {
+        // 远程客户端不得在服务端创建或覆盖文件
+        if (request->input_fd != STDIN_FILENO) {
+            request->is_success = false;
+            set_request_result(request, "Export to file is only allowed from local console.");
+            return;
+        }
+        output_fd = open(query->export_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (output_fd < 0) {
+            request->is_success = false;
+            set_request_result(request, "Failed to open export file [%s].", query->export_path);
+            return;
+        }
+    }
+
+    export_writer_t *writer = mem_calloc(MEM_RESULT, 1, sizeof(export_writer_t));
+    if (writer == NULL) {
+        request->is_success = false;
+        set_request_result(request, "Failed to export staffs for no memory.");
+        goto END;
+    }
+    init_export_writer(writer, output_fd, query->export_format);
+
+    // 无需排序时直接遍历数据库，需排序时仅缓存指针数组
+    if (query->sort_order.count == 0) {
+        traverse_database(&query->info, export_a_staff, writer);
+    }
+    else {
+        uint64_t count = 0;
+        staff_info_t **staff_infos = get_by_info_from_database(&query->info, &count);
+        sort_staffs(staff_infos, count, &query->sort_order);
+        if (staff_infos != NULL) {
+            for (uint64_t i = 0; i < count && export_a_staff(staff_infos[i], writer); i++);
+        }
+        MEM_FREE(MEM_RESULT, staff_infos)
+    }
+
+    request->is_success = finish_export(writer);
+    if (request->is_success) {
+        set_request_result(request, "Total [%llu] staffs are exported.", writer->count);
+    }
+    else {
+        set_request_result(request, "Failed to export staffs after [%llu] exported.", writer->count);
+    }
+    MEM_FREE(MEM_RESULT, writer)
+
+END:
+    if (query->export_path != NULL) {
+        close(output_fd);
+    }
+}
+
+/**
+ * @brief           比较分组值
+ * @param group1    分组1
+ * @param group2    分组2
+ * @return          比较结果
+ */
+STATIC int compare_group_value(const void *group1, const void *group2) {
+    group_count_t *info1 = *(group_count_t **)group1;
+    group_count_t *info2 = *(group_count_t **)group2;
+    return strcmp(info1->value, info2->value);
+}
+
+/**
+ * @brief           统计员工数量[由增量维护的计数直接得出，不遍历员工]
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void count_employee(query_info_t *query, user_request_t *request) {
+    request->is_success = true;
+    if (query->group_type == GROUP_NONE) {
+        set_request_result(request, "Total [%llu] staffs.", get_count_from_database());
+        return;
+    }
+
+    uint64_t count = 0;
+    group_count_t **groups = get_group_counts_from_database(query->group_type, &count);
+    if (groups != NULL) {
+        qsort(groups, count, sizeof(group_count_t *), compare_group_value);
+    }
+    for (uint64_t i = 0; i < count; i++) {
+        if (groups[i]->count == 0) {
+            continue;
+        }
+        append_request_result(request, "[%s]: [%llu] staffs.\n", groups[i]->value, groups[i]->count);
+    }
+    if (get_request_result_length(request) == 0) {
+        set_request_result(request, "No items are found.");
+    }
+    MEM_FREE(MEM_RESULT, groups)
+}
+
+/**
+ * @brief           输出运行统计信息
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void stat_runtime(query_info_t *query, user_request_t *request) {
+    query_cache_stat_t cache_stat = {0};
+    query_cache_stat_t record_stat = {0};
+    repl_stat_t repl_stat = {0};
+    bloom_stat_t filter_stat = {0};
+    get_query_cache_stat(&cache_stat);
+    get_record_cache_stat(&record_stat);
+    get_replication_stat(&repl_stat);
+
+    append_request_result(request, "Query cache: entries [%u/%u], hits [%llu], misses [%llu], "
+        "evictions [%llu], invalidations [%llu].\n", cache_stat.entries, cache_stat.capacity,
+        cache_stat.hits, cache_stat.misses, cache_stat.evictions, cache_stat.invalidations);
+    append_request_result(request, "Record cache: entries [%u/%u], hits [%llu], misses [%llu], "
+        "evictions [%llu], invalidations [%llu].\n", record_stat.entries, record_stat.capacity,
+        record_stat.hits, record_stat.misses, record_stat.evictions, record_stat.invalidations);
+    if (!get_id_filter_stat(&filter_stat)) {
+        append_request_result(request, "Id filter: off.\n");
+    }
+    else {
+        // 误判率为不存在的工号中未被过滤器排除的比例
+        uint64_t absents = filter_stat.negatives + filter_stat.false_positives;
+        append_request_result(request, "Id filter: blocks [%llu], items [%llu], lookups [%llu], "
+            "definite misses [%llu], false positives [%llu], false positive rate [%.2f%%].\n", filter_stat.blocks,
+            filter_stat.items, filter_stat.lookups, filter_stat.negatives, filter_stat.false_positives,
+            absents == 0 ? 0.0 : 100.0 * filter_stat.false_positives / absents);
+    }
+    if (repl_stat.role == REPL_FOLLOWER) {
+        append_request_result(request, "Replication: role [%s], connected [%d], synced [%d], "
+            "applied sequence [%llu], lag [%llu] ms, buffered [%llu] bytes.\n", repl_role_str[repl_stat.role],
+            repl_stat.is_connected, repl_stat.is_synced, repl_stat.sequence, repl_stat.lag_ms, repl_stat.buffered);
+    }
+    else {
+        append_request_result(request, "Replication: role [%s], sequence [%llu], followers [%u].\n",
+            repl_role_str[repl_stat.role], repl_stat.sequence, repl_stat.followers);
+    }
+    for (gate_mode_t i = GATE_SHARED; i < GATE_MAX; i++) {
+        gate_stat_t gate_stat = {0};
+        get_command_gate_stat(i, &gate_stat);
+        append_request_result(request, "Gate [%s]: acquisitions [%llu], contended [%llu], wait [%llu] us, max wait [%llu] us.\n",
+            gate_mode_str[i], gate_stat.acquisitions, gate_stat.contentions, gate_stat.wait_us, gate_stat.max_wait_us);
+    }
+    append_request_result(request, "Scan slices: yields [%llu], restarts [%llu].\n",
+        atomic_load(&s_slice_yields), atomic_load(&s_slice_restarts));
+    for (query_priority_t i = PRIORITY_HIGH; i < PRIORITY_MAX; i++) {
+        request_queue_stat_t queue_stat = {0};
+        get_request_queue_stat(i, &queue_stat);
+        if (queue_stat.workers == 0) {
+            append_request_result(request, "Request queue [%s]: off.\n", priority_str[i]);
+            continue;
+        }
+        append_request_result(request, "Request queue [%s]: workers [%u], depth [%llu/%u], max depth [%llu], completed [%llu], "
+            "wait [%llu] us, max wait [%llu] us, exec [%llu] us, max exec [%llu] us.\n", priority_str[i], queue_stat.workers,
+            queue_stat.depth, queue_stat.capacity, queue_stat.max_depth, queue_stat.completed, queue_stat.wait_us,
+            queue_stat.max_wait_us, queue_stat.exec_us, queue_stat.max_exec_us);
+    }
+    request->is_success = true;
+}
+
+/**
+ * @brief           输出各分类内存占用[按分配器实际占用字节统计]
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void stat_memory(query_info_t *query, user_request_t *request) {
+    mem_stat_t stat = {0};
+
+    for (mem_type_t i = MEM_OTHER; i <= MEM_MAX; i++) {
+        get_mem_stat(i, &stat);
+        append_request_result(request, "[%s]: current [%llu] bytes, peak [%llu] bytes, blocks [%llu].\n",
+            mem_type_str[i], stat.current, stat.peak, stat.blocks);
+    }
+    uint64_t count = get_count_from_database();
+    if (count > 0) {
+        append_request_result(request, "Total [%llu] staffs, [%llu] bytes per staff.\n", count, stat.current / count);
+    }
+    request->is_success = true;
+}
+
+/**
+ * @brief       深拷贝员工信息
+ * @param info  员工信息
+ * @return      NULL表示失败，否则为拷贝结果
+ */
+STATIC staff_info_t *copy_staff_info(const staff_info_t *info) {
+    staff_info_t *copy = mem_calloc(MEM_OTHER, 1, sizeof(staff_info_t));
+    if (copy == NULL) {
+        return NULL;
+    }
+    copy->staff_id = info->staff_id;
+    copy->date = info->date;
+    copy->name = info->name != NULL ? mem_strndup(MEM_STRING, info->name, strlen(info->name)) : NULL;
+    copy->department = info->department != NULL ? mem_strndup(MEM_STRING, info->department, strlen(info->department)) : NULL;
+    copy->position = info->position != NULL ? mem_strndup(MEM_STRING, info->position, strlen(info->position)) : NULL;
+    return copy;
+}
+
+/**
+ * @brief       释放员工信息拷贝
+ * @param info  员工信息
+ */
+STATIC void free_staff_info(staff_info_t *info) {
+    if (info == NULL) {
+        return;
+    }
+    MEM_FREE(MEM_STRING, info->name)
+    MEM_FREE(MEM_STRING, info->department)
+    MEM_FREE(MEM_STRING, info->position)
+    MEM_FREE(MEM_OTHER, info)
+}
+
+/**
+ * @brief       撤销单条已执行指令[恢复执行前员工信息，调用方持有执行权；失败的批处理不推送复制，撤销亦无需推送]
+ * @param undo  撤销记录
+ */
+STATIC void undo_batch_query(batch_undo_t *undo) {
+    if (get_by_id_from_database(undo->staff_id) != NULL) {
+        remove_item_from_database(undo->staff_id);
+    }
+    if (undo->origin != NULL) {
+        add_item_to_database(undo->origin);
+    }
+}
+
+/**
+ * @brief           将增删改指令加入批处理[入队后字符串归批处理所有，原查询字符串置空]
+ * @param batch     批处理
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void queue_batch_query(command_batch_t *batch, query_info_t *query, user_request_t *request) {
+    if (query->is_opt_all) {
+        batch->is_failed = true;
+        request->is_success = false;
+        set_request_result(request, "'DEL *' is not supported in a batch, the batch will be aborted.");
+        return;
+    }
+    // 批量删除及试运行无法逐个记录撤销信息
+    if (query->command == CMD_DEL && (query->info.staff_id == 0 || query->is_dry_run)) {
+        batch->is_failed = true;
+        request->is_success = false;
+        set_request_result(request, "Filtered or dry-run 'DEL' is not supported in a batch, the batch will be aborted.");
+        return;
+    }
+    if (batch->count == batch->capacity) {
+        uint32_t capacity = batch->capacity == 0 ? 16 : batch->capacity * 2;
+        query_info_t *queries = mem_realloc(MEM_OTHER, batch->queries, capacity * sizeof(query_info_t));
+        if (queries == NULL) {
+            batch->is_failed = true;
+            request->is_success = false;
+            set_request_result(request, "Failed to queue the command, the batch will be aborted.");
+            return;
+        }
+        batch->queries = queries;
+        batch->capacity = capacity;
+    }
+
+    batch->queries[batch->count++] = *query;
+    query->info.name = NULL;
+    query->info.department = NULL;
+    query->info.position = NULL;
+    query->export_path = NULL;
+    request->is_success = true;
+    set_request_result(request, "Command [%u] is queued.", batch->count);
+}
+
+/**
+ * @brief           开始批处理
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void begin_batch(query_info_t *query, user_request_t *request) {
+    request->is_success = false;
+    if (is_replication_read_only()) {
+        set_request_result(request, "The server is a read-only follower, 'BEGIN' is rejected.");
+        return;
+    }
+    if (s_batches[request->input_fd] != NULL) {
+        set_request_result(request, "A batch is already in progress.");
+        return;
+    }
+    s_batches[request->input_fd] = mem_calloc(MEM_OTHER, 1, sizeof(command_batch_t));
+    if (s_batches[request->input_fd] == NULL) {
+        set_request_result(request, "Failed to begin a batch.");
+        return;
+    }
+    request->is_success = true;
+    set_request_result(request, "Batch is begun, 'ADD', 'DEL' and 'MOD' will be queued until 'COMMIT'.");
+}
+
+/**
+ * @brief           提交批处理[仅获取一次执行权，任一指令失败则撤销已执行指令；变更于提交成功后整体推送至跟随者]
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void commit_batch(query_info_t *query, user_request_t *request) {
+    uint8_t input_fd = request->input_fd;
+    command_batch_t *batch = s_batches[input_fd];
+    request->is_success = false;
+    if (batch == NULL) {
+        set_request_result(request, "No batch is in progress.");
+        return;
+    }
+    if (batch->is_failed) {
+        clear_command_batch(input_fd);
+        set_request_result(request, "Batch is aborted for invalid commands, nothing is changed.");
+        return;
+    }
+    batch_undo_t *undos = mem_calloc(MEM_OTHER, batch->count + 1, sizeof(batch_undo_t));   // 空批处理亦申请一项
+    if (undos == NULL) {
+        clear_command_batch(input_fd);
+        set_request_result(request, "Failed to commit the batch, nothing is changed.");
+        return;
+    }
+
+    uint32_t done = 0;
+    acquire_command_gate(GATE_EXCLUSIVE);
+    begin_replication_batch();
+    for (; done < batch->count; done++) {
+        query_info_t *item = &batch->queries[done];
+        staff_info_t *origin = get_by_id_from_database(item->info.staff_id);
+        undos[done].staff_id = item->info.staff_id;
+        undos[done].origin = origin != NULL ? copy_staff_info(origin) : NULL;
+        if (origin != NULL && undos[done].origin == NULL) {
+            set_request_result(request, "Failed to backup the staff [%llu].", item->info.staff_id);
+            break;
+        }
+        g_cmd_infos[item->command].func(item, request);
+        if (!request->is_success) {
+            break;
+        }
+    }
+    if (done < batch->count) {
+        for (uint32_t i = done; i > 0; i--) {
+            undo_batch_query(&undos[i-1]);
+        }
+    }
+    end_replication_batch(done == batch->count);
+    release_command_gate();
+
+    if (done < batch->count) {
+        append_request_result(request, " Batch is rolled back at command [%u].", done + 1);
+        request->is_success = false;
+    }
+    else {
+        set_request_result(request, "Batch of [%u] commands is committed.", batch->count);
+        request->is_success = true;
+    }
+    for (uint32_t i = 0; i < batch->count; i++) {
+        free_staff_info(undos[i].origin);
+    }
+    MEM_FREE(MEM_OTHER, undos)
+    clear_command_batch(input_fd);
+}
+
+/**
+ * @brief           放弃批处理
+ * @param query     查询信息
+ * @param request   原始请求
+ */
+STATIC void rollback_batch(query_info_t *query, user_request_t *request) {
+    if (s_batches[request->input_fd] == NULL) {
+        request->is_success = false;
+        set_request_result(request, "No batch is in progress.");
+        return;
+    }
+    clear_command_batch(request->input_fd);
+    request->is_success = true;
+    set_request_result(request, "Batch is discarded, nothing is changed.");
+}
+
 /**
  * @brief 初始化所有指令信息
  */
@@ -188,9 +882,12 @@ __attribute__((constructor)) void init_all_cmd_info(void) {
 
     g_cmd_infos[CMD_DEL].name = "DEL";
     g_cmd_infos[CMD_DEL].func = del_employee;
-    g_cmd_infos[CMD_DEL].param = INPUT_GLOBAL | INPUT_INFO;
+    g_cmd_infos[CMD_DEL].param = INPUT_GLOBAL | INPUT_INFO | INPUT_RANGE;
     g_cmd_infos[CMD_DEL].usage = "Use 'DEL' cmd to remove a/all staff from the database.\n"
-        "\te.g. [DEL id:10086] to remove a staff, or [DEL *] to clear the database.\n";
+        "\te.g. [DEL id:10086] to remove a staff, or [DEL *] to clear the database.\n"
+        "\tIf you want to remove matching staffs in one pass, use info and '--from:/--to:' date range, "
+        "e.g. [DEL dept:ZTA pos:QA --from:2020-01-01 --to:2021-12-31].\n"
+        "\tIf you want to preview the number of staffs to remove, use '--dry', e.g. [DEL dept:ZTA --dry].\n";
 
     g_cmd_infos[CMD_MOD].name = "MOD";
     g_cmd_infos[CMD_MOD].func = mod_employee;
@@ -200,11 +897,51 @@ __attribute__((constructor)) void init_all_cmd_info(void) {
 
     g_cmd_infos[CMD_GET].name = "GET";
     g_cmd_infos[CMD_GET].func = get_employee;
-    g_cmd_infos[CMD_GET].param = INPUT_SORT | INPUT_GLOBAL | INPUT_INFO;
+    g_cmd_infos[CMD_GET].param = INPUT_SORT | INPUT_GLOBAL | INPUT_INFO | INPUT_PAGE | INPUT_PATTERN | INPUT_IDS;
     g_cmd_infos[CMD_GET].usage = "Use 'GET' cmd to obtain a/all staff's info.\n"
         "\te.g. [GET id:10086] to obtain a staff's info, or [GET name:Lisi dept:ZTA] to obtain one or more staff's info, "
         "or [GET *] to print all staff's info.\n"
-        "\tIf you want output being sorted, use '--sort:id/date', e.g. [GET --sort:id *] to sort output by staff id.\n";
+        "\tIf you want many staffs by id in one request, use 'id:' with commas or '--ids:' with a server-side file of ids (local console only), "
+        "e.g. [GET id:10086,10087,10088] or [GET --ids:/tmp/ids.txt].\n"
+        "\tIf you want to match part of name, use 'name~:' for prefix or 'name%:' for substring, e.g. [GET name~:Zha] or [GET name%:ang].\n"
+        "\tIf you want to match misspelled name, use 'name?:' with '--dist:N' [1-4, default 2], e.g. [GET name?:Zhangsn --dist:1].\n"
+        "\tIf you want output being sorted, use '--sort:' with fields [id/date/name/dept/pos] each optionally followed by ':asc' or ':desc', "
+        "e.g. [GET --sort:id *] to sort output by staff id, or [GET --sort:dept,date:desc,name *] to sort by department, newest first.\n"
+        "\tIf you want output being paged, use '--limit:N' and '--offset:M', e.g. [GET --sort:date --limit:50 *].\n";
+
+    g_cmd_infos[CMD_EXPORT].name = "EXPORT";
+    g_cmd_infos[CMD_EXPORT].func = export_employee;
+    g_cmd_infos[CMD_EXPORT].param = INPUT_SORT | INPUT_GLOBAL | INPUT_INFO | INPUT_EXPORT;
+    g_cmd_infos[CMD_EXPORT].usage = "Use 'EXPORT' cmd to stream all/matching staff's info as csv or jsonl.\n"
+        "\te.g. [EXPORT *] to export all staffs in csv to requester, or [EXPORT --format:jsonl --file:/tmp/staffs.jsonl dept:ZTA] "
+        "to export staffs of a department to a server-side file (local console only).\n"
+        "\tIf you want output being sorted, use '--sort:' as GET does, e.g. [EXPORT --sort:dept,date:desc *].\n";
+
+    g_cmd_infos[CMD_COUNT].name = "COUNT";
+    g_cmd_infos[CMD_COUNT].func = count_employee;
+    g_cmd_infos[CMD_COUNT].param = INPUT_GROUP;
+    g_cmd_infos[CMD_COUNT].usage = "Use 'COUNT' cmd to obtain number of staffs.\n"
+        "\te.g. [COUNT] to obtain total number, or [COUNT --group:dept] to obtain number per department. "
+        "Group include [dept, pos, year].\n";
+
+    g_cmd_infos[CMD_BEGIN].name = "BEGIN";
+    g_cmd_infos[CMD_BEGIN].func = begin_batch;
+    g_cmd_infos[CMD_BEGIN].usage = "Use 'BEGIN' cmd to queue 'ADD', 'DEL' and 'MOD' until 'COMMIT' applies them atomically or 'ROLLBACK' discards them.\n"
+        "\te.g. [BEGIN], [MOD id:10086 dept:CWPP], [MOD id:10087 dept:CWPP], [COMMIT]. Any failure rolls back the whole batch.\n";
+    g_cmd_infos[CMD_COMMIT].name = "COMMIT";
+    g_cmd_infos[CMD_COMMIT].func = commit_batch;
+    g_cmd_infos[CMD_ROLLBACK].name = "ROLLBACK";
+    g_cmd_infos[CMD_ROLLBACK].func = rollback_batch;
+
+    g_cmd_infos[CMD_STAT].name = "STAT";
+    g_cmd_infos[CMD_STAT].func = stat_runtime;
+    g_cmd_infos[CMD_STAT].usage = "Use 'STAT' cmd to print runtime statistics.\n"
+        "\te.g. [STAT] to print hits, misses and evictions of the query and record caches, id filter false positive rate, replication role, sequence and lag, command gate contention and wait time, request queue depth and execution time per priority, and scan slice yields.\n";
+
+    g_cmd_infos[CMD_MEM].name = "MEM";
+    g_cmd_infos[CMD_MEM].func = stat_memory;
+    g_cmd_infos[CMD_MEM].usage = "Use 'MEM' cmd to print current and peak memory by category.\n"
+        "\te.g. [MEM] to print bytes of tables, nodes, records, strings, indexes and query results.\n";
 
     g_cmd_infos[CMD_LOG].name = "LOG";
     g_cmd_infos[CMD_LOG].param = INPUT_LOG;
@@ -214,6 +951,243 @@ __attribute__((constructor)) void init_all_cmd_info(void) {
     g_cmd_infos[CMD_EXIT].name = "EXIT";
 }
 
+/**
+ * @brief 初始化指令执行权[glibc默认读优先，设置为写优先以免持续查询时变更指令饥饿]
+ */
+__attribute__((constructor)) static void init_command_gate(void) {
+    pthread_rwlockattr_t attr;
+    pthread_rwlockattr_init(&attr);
+#if defined(__GLIBC__) && defined(_GNU_SOURCE)
+    pthread_rwlockattr_setkind_np(&attr, PTHREAD_RWLOCK_PREFER_WRITER_NONRECURSIVE_NP);
+#endif
+    pthread_rwlock_init(&s_command_gate, &attr);
+    pthread_rwlockattr_destroy(&attr);
+}
+
+/**
+ * @brief       获取指令执行权[只读指令共享执行，变更指令独占执行；无需等待时不计时]
+ * @param mode  执行权模式
+ */
+void acquire_command_gate(gate_mode_t mode) {
+    gate_counter_t *counter = &s_gate_counters[mode];
+    bool is_shared = mode == GATE_SHARED;
+    if ((is_shared ? pthread_rwlock_tryrdlock(&s_command_gate) : pthread_rwlock_trywrlock(&s_command_gate)) != 0) {
+        uint64_t begin = get_monotonic_ns();
+        if (is_shared) {
+            pthread_rwlock_rdlock(&s_command_gate);
+        }
+        else {
+            // 低优先级扫描据此在时间片间让出执行权
+            atomic_fetch_add(&s_exclusive_waiters, 1);
+            pthread_rwlock_wrlock(&s_command_gate);
+            atomic_fetch_sub(&s_exclusive_waiters, 1);
+        }
+        uint64_t wait = get_monotonic_ns() - begin;
+        atomic_fetch_add(&counter->contentions, 1);
+        atomic_fetch_add(&counter->wait_ns, wait);
+        update_atomic_maximum(&counter->max_wait_ns, wait);
+    }
+    atomic_fetch_add(&counter->acquisitions, 1);
+}
+
+/**
+ * @brief 释放指令执行权
+ */
+void release_command_gate(void) {
+    pthread_rwlock_unlock(&s_command_gate);
+}
+
+/**
+ * @brief       获取执行权统计
+ * @param mode  执行权模式
+ * @param stat  统计信息存放地址
+ */
+void get_command_gate_stat(gate_mode_t mode, gate_stat_t *stat) {
+    if (mode >= GATE_MAX || stat == NULL) {
+        return;
+    }
+    gate_counter_t *counter = &s_gate_counters[mode];
+    stat->acquisitions = atomic_load(&counter->acquisitions);
+    stat->contentions = atomic_load(&counter->contentions);
+    stat->wait_us = atomic_load(&counter->wait_ns) / 1000;
+    stat->max_wait_us = atomic_load(&counter->max_wait_ns) / 1000;
+}
+
+/**
+ * @brief           预留结果写入空间[result放不下时转存至按需倍增的output，均摊O(1)]
+ * @param request   原始请求
+ * @param size      待写入长度[不含结尾'\0']
+ * @return          NULL表示失败，否则为当前写入位置[写入后须调用commit_request_result]
+ */
+char *reserve_request_result(user_request_t *request, size_t size) {
+    char *buffer = request->output != NULL ? request->output : request->result;
+    size_t capacity = request->output != NULL ? request->capacity : BUFSIZ;
+    if (request->length + size < capacity) {
+        return buffer + request->length;
+    }
+
+    size_t new_capacity = capacity * 2;
+    while (new_capacity <= request->length + size) {
+        new_capacity *= 2;
+    }
+    char *output = mem_realloc(MEM_RESULT, request->output, new_capacity);
+    if (output == NULL) {
+        LOG_C(LOG_ERROR, "Failed to realloc resources for request result.")
+        return NULL;
+    }
+    if (request->output == NULL) {
+        memcpy(output, request->result, request->length);
+    }
+    request->output = output;
+    request->capacity = new_capacity;
+    return output + request->length;
+}
+
+/**
+ * @brief           确认已写入预留空间的结果，移动写入位置并补充结尾'\0'
+ * @param request   原始请求
+ * @param size      已写入长度[不超过预留长度]
+ */
+void commit_request_result(user_request_t *request, size_t size) {
+    char *buffer = request->output != NULL ? request->output : request->result;
+    request->length += size;
+    buffer[request->length] = '\0';
+}
+
+/**
+ * @brief           追加定长文本
+ * @param request   原始请求
+ * @param text      文本
+ * @param length    文本长度
+ */
+void append_request_text(user_request_t *request, const char *text, size_t length) {
+    if (request == NULL || text == NULL) {
+        return;
+    }
+    char *cursor = reserve_request_result(request, length);
+    if (cursor != NULL) {
+        memcpy(cursor, text, length);
+        commit_request_result(request, length);
+    }
+}
+
+/**
+ * @brief           按参数列表追加格式化结果[先尝试写入剩余空间，放不下时预留后重新格式化]
+ * @param request   原始请求
+ * @param format    格式字符串
+ * @param args      参数列表
+ */
+static void append_request_args(user_request_t *request, const char *format, va_list args) {
+    va_list copy;
+    char *buffer = request->output != NULL ? request->output : request->result;
+    size_t capacity = request->output != NULL ? request->capacity : BUFSIZ;
+    va_copy(copy, args);
+    int size = vsnprintf(buffer+request->length, capacity-request->length, format, copy);
+    va_end(copy);
+    if (size < 0) {
+        buffer[request->length] = '\0';
+        return;
+    }
+    if (request->length + size >= capacity) {
+        char *cursor = reserve_request_result(request, size);
+        if (cursor == NULL) {
+            buffer[request->length] = '\0';
+            return;
+        }
+        vsnprintf(cursor, size + 1, format, args);
+    }
+    request->length += size;
+}
+
+/**
+ * @brief           追加格式化结果[结果不再截断]
+ * @param request   原始请求
+ * @param format    格式字符串
+ */
+void append_request_result(user_request_t *request, const char *format, ...) {
+    if (request == NULL || format == NULL) {
+        return;
+    }
+    va_list args;
+    va_start(args, format);
+    append_request_args(request, format, args);
+    va_end(args);
+}
+
+/**
+ * @brief           设置格式化结果[清除已有结果]
+ * @param request   原始请求
+ * @param format    格式字符串
+ */
+void set_request_result(user_request_t *request, const char *format, ...) {
+    if (request == NULL || format == NULL) {
+        return;
+    }
+    va_list args;
+    clear_request_result(request);
+    va_start(args, format);
+    append_request_args(request, format, args);
+    va_end(args);
+}
+
+/**
+ * @brief           获取完整查询结果
+ * @param request   原始请求
+ * @return          查询结果[以'\0'结尾]
+ */
+const char *get_request_result(const user_request_t *request) {
+    return request->output != NULL ? request->output : request->result;
+}
+
+/**
+ * @brief           获取完整查询结果长度
+ * @param request   原始请求
+ * @return          结果长度[不含结尾'\0']
+ */
+size_t get_request_result_length(const user_request_t *request) {
+    return request->length;
+}
+
+/**
+ * @brief           释放完整查询结果[请求发送后调用]
+ * @param request   原始请求
+ */
+void clear_request_result(user_request_t *request) {
+    if (request == NULL) {
+        return;
+    }
+    MEM_FREE(MEM_RESULT, request->output)
+    request->result[0] = '\0';
+    request->length = 0;
+    request->capacity = 0;
+}
+
+/**
+ * @brief           判定请求优先级[按少量工号查询及单条增删改为高优先级，需遍历员工、大量工号查询、导出或批量变更为低优先级]
+ * @param query     查询信息
+ * @return          请求优先级
+ */
+query_priority_t classify_query_priority(const query_info_t *query) {
+    if (query == NULL) {
+        return PRIORITY_HIGH;
+    }
+
+    switch (query->command) {
+        case CMD_GET:
+            if (query->id_count != 0) {
+                return query->id_count > max_high_priority_ids ? PRIORITY_LOW : PRIORITY_HIGH;
+            }
+            return query->is_opt_all || query->info.staff_id == 0 ? PRIORITY_LOW : PRIORITY_HIGH;
+        case CMD_DEL:
+            return query->is_opt_all || query->info.staff_id == 0 ? PRIORITY_LOW : PRIORITY_HIGH;
+        case CMD_EXPORT:
+        case CMD_COMMIT:
+            return PRIORITY_LOW;
+        default:
+            return PRIORITY_HIGH;
+    }
+}
+
 /**
  * @brief           执行输入指令
  * @param query     查询信息
@@ -225,42 +1199,60 @@ void execute_input_command(query_info_t *query, user_request_t *request) {
     }
 
     command_info_t *cmd_info = NULL;
-    size_t rest = 0;
+    gate_mode_t mode = GATE_SHARED;
+    command_batch_t *batch = s_batches[request->input_fd];
+    // 各指令结果均由空结果开始追加
+    clear_request_result(request);
+    // 批处理进行中，增删改指令仅入队，COMMIT时统一执行
+    if (batch != NULL && (query->command == CMD_ADD || query->command == CMD_DEL || query->command == CMD_MOD)) {
+        queue_batch_query(batch, query, request);
+        return;
+    }
+
     switch (query->command) {
         case CMD_ADD:
         case CMD_DEL:
         case CMD_MOD:
+            if (is_replication_read_only()) {
+                set_request_result(request, "The server is a read-only follower, '%s' is rejected.", g_cmd_infos[query->command].name);
+                request->is_success = false;
+                return;
+            }
+            mode = GATE_EXCLUSIVE;
         case CMD_GET:
-            do {
-                usleep(100);
-            } while (active_request == 1);
-            atomic_fetch_add(&active_request, 1);
+        case CMD_EXPORT:
+        case CMD_COUNT:
+        case CMD_STAT:
+        case CMD_MEM:
+            acquire_command_gate(mode);
             cmd_info = &g_cmd_infos[query->command];
             break;
 
+        case CMD_BEGIN:
+        case CMD_COMMIT:
+        case CMD_ROLLBACK:
+            // 批处理指令自行管理执行权[COMMIT仅获取一次]
+            g_cmd_infos[query->command].func(query, request);
+            return;
+
         case CMD_LOG:
-              snprintf(request->result, BUFSIZ, "LOG level is setted.");
+              set_request_result(request, "LOG level is setted.");
               request->is_success = true;
               return;
         case CMD_HELP:
             for (user_command_t i = CMD_NUL + 1; i < CMD_MAX; ++i) {
-                if (g_cmd_infos[i].usage == NULL) {
-                    continue;
+                if (g_cmd_infos[i].usage != NULL) {
+                    append_request_text(request, g_cmd_infos[i].usage, strlen(g_cmd_infos[i].usage));
                 }
-                rest = BUFSIZ - strlen(request->result);
-                rest = rest > strlen(g_cmd_infos[i].usage) ? rest : strlen(g_cmd_infos[i].usage);
-                strncat(request->result, g_cmd_infos[i].usage, rest);
             }
-            rest = BUFSIZ - strlen(request->result);
-            strncat(request->result, "The above commands are not case sensitive.\n", rest);
+            append_request_result(request, "The above commands are not case sensitive.\n");
             request->is_success = true;
             return;
         case CMD_EXIT:
-            uninit_socket_server();
-            delete_database();
+            // 由输入线程退出主循环后释放资源，不与其并发
+            stop_socket_server();
             request->is_success = true;
-            snprintf(request->result, BUFSIZ, "Process is over, now quit.");
-            exit(0);
+            set_request_result(request, "Process is over, now quit.");
             return;
             
         default:
@@ -268,5 +1260,34 @@ void execute_input_command(query_info_t *query, user_request_t *request) {
     }
 
     cmd_info->func(query, request);
-    atomic_fetch_sub(&active_request, 1);
+    release_command_gate();
+}
+
+/**
+ * @brief           标记批处理失败[批内指令解析失败时调用，COMMIT将放弃整个批处理]
+ * @param input_fd  输入描述符
+ */
+void fail_command_batch(uint8_t input_fd) {
+    if (s_batches[input_fd] != NULL) {
+        s_batches[input_fd]->is_failed = true;
+    }
+}
+
+/**
+ * @brief           清理批处理[释放已入队指令]
+ * @param input_fd  输入描述符
+ */
+void clear_command_batch(uint8_t input_fd) {
+    command_batch_t *batch = s_batches[input_fd];
+    if (batch == NULL) {
+        return;
+    }
+    for (uint32_t i = 0; i < batch->count; i++) {
+        MEM_FREE(MEM_STRING, batch->queries[i].info.name)
+        MEM_FREE(MEM_STRING, batch->queries[i].info.department)
+        MEM_FREE(MEM_STRING, batch->queries[i].info.position)
+        MEM_FREE(MEM_STRING, batch->queries[i].export_path)
+    }
+    MEM_FREE(MEM_OTHER, batch->queries)
+    MEM_FREE(MEM_OTHER, s_batches[input_fd])
 }
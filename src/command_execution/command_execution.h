@@ -22,7 +22,14 @@ typedef enum {
     CMD_DEL,    // 删
     CMD_MOD,    // 改
     CMD_GET,    // 查
+    CMD_EXPORT, // 导出
+    CMD_COUNT,  // 计数
+    CMD_BEGIN,  // 开始批处理
+    CMD_COMMIT, // 提交批处理
+    CMD_ROLLBACK,   // 放弃批处理
     
+    CMD_STAT,   // 统计
+    CMD_MEM,    // 内存
     CMD_LOG,    // 日志
     CMD_HELP,   // 帮助
     CMD_EXIT,   // 退出
@@ -50,7 +57,13 @@ typedef enum {
     INPUT_GLOBAL    = 1 << 1,   // 全局操作标志
     INPUT_LOG       = 1 << 2,   // log级别
     INPUT_ID        = 1 << 3,   // 员工工号[INPUT_INFO子集，必选]
-    INPUT_INFO      = 1 << 4    // 员工信息[表示可选]
+    INPUT_INFO      = 1 << 4,   // 员工信息[表示可选]
+    INPUT_EXPORT    = 1 << 5,   // 导出格式及路径
+    INPUT_GROUP     = 1 << 6,   // 分组方式
+    INPUT_PAGE      = 1 << 7,   // 分页数量及偏移
+    INPUT_PATTERN   = 1 << 8,   // 姓名前缀、子串或模糊匹配
+    INPUT_RANGE     = 1 << 9,   // 入职日期区间及试运行
+    INPUT_IDS       = 1 << 10   // 多个工号[逗号分隔或工号文件]
 } param_type_t;
 
 /**
@@ -60,15 +73,69 @@ typedef enum {
     SORT_NONE,  // 无需排序
     SORT_ID,    // 按工号排序
     SORT_DATE,  // 按日期排序
+    SORT_NAME,  // 按姓名排序
+    SORT_DEPT,  // 按部门排序
+    SORT_POS,   // 按职位排序
     SORT_MAX
 } sort_type_t;
 
+#define MAX_SORT_KEYS   (SORT_MAX - 1)  // 最多排序字段数量[各字段最多出现一次]
+
+/**
+ * @brief 排序规则[按字段优先级依次比较]
+ */
+typedef struct {
+    sort_type_t types[MAX_SORT_KEYS];   // 排序字段
+    bool is_desc[MAX_SORT_KEYS];        // 是否降序
+    uint8_t count;                      // 排序字段数量[0表示无需排序]
+} sort_order_t;
+
+/**
+ * @brief 指令执行权模式
+ */
+typedef enum {
+    GATE_SHARED,    // 共享执行权[只读指令]
+    GATE_EXCLUSIVE, // 独占执行权[增删改、批处理提交及复制]
+    GATE_MAX
+} gate_mode_t;
+
+/**
+ * @brief 指令执行权统计
+ */
+typedef struct {
+    uint64_t acquisitions;  // 获取次数
+    uint64_t contentions;   // 需等待的获取次数
+    uint64_t wait_us;       // 累计等待时长[微秒]
+    uint64_t max_wait_us;   // 最长等待时长[微秒]
+} gate_stat_t;
+
+/**
+ * @brief 请求优先级[解析时确定]
+ */
+typedef enum {
+    PRIORITY_HIGH,  // 高优先级[按工号查询、单条增删改等低延迟请求]
+    PRIORITY_LOW,   // 低优先级[遍历查询、导出、批量删除及批处理提交，扫描分时间片执行]
+    PRIORITY_MAX
+} query_priority_t;
+
+/**
+ * @brief 导出格式
+ */
+typedef enum {
+    EXPORT_CSV,     // CSV格式[默认]
+    EXPORT_JSONL,   // JSON Lines格式
+    EXPORT_MAX
+} export_format_t;
+
 /**
  * @brief 用户请求处理
  */
 typedef struct{
     char request[BUFSIZ];   // 用户原始输入
-    char result[BUFSIZ];    // 用户查询结果
+    char result[BUFSIZ];    // 用户查询结果[超出时转存至output，须经request结果接口写入]
+    char *output;           // 完整查询结果[按需倍增，按MEM_RESULT分类申请，NULL表示结果位于result]
+    size_t length;          // 查询结果长度[写入位置]
+    size_t capacity;        // 完整查询结果容量
     uint8_t input_fd;       // 输入描述符[0-stdin, >0-remote]
     bool is_success;        // 请求处理成功标志
 } user_request_t;
@@ -79,8 +146,22 @@ typedef struct{
 typedef struct{
     user_command_t command; // 操作指令
     staff_info_t info;      // 员工信息
+    name_match_t name_match;    // 姓名匹配方式[仅GET指令支持前缀、子串及模糊匹配]
+    uint8_t max_distance;   // 姓名最大编辑距离[仅模糊匹配使用]
     bool is_opt_all;        // 全局操作标志[仅DEL、GET指令支持]
-    sort_type_t sort_type;  // 排序方式[仅GET指令支持]
+    sort_order_t sort_order;    // 排序规则[仅GET、EXPORT指令支持]
+    uint64_t limit;         // 最多输出数量[仅GET指令支持，0表示不限制]
+    uint64_t offset;        // 输出偏移[仅GET指令支持]
+    export_format_t export_format;  // 导出格式[仅EXPORT指令支持]
+    char *export_path;      // 导出文件路径[仅EXPORT指令支持，NULL表示输出至请求方]
+    group_type_t group_type;    // 分组方式[仅COUNT指令支持]
+    uint64_t date_from;     // 入职日期下限[仅DEL指令支持，含，0表示不限]
+    uint64_t date_to;       // 入职日期上限[仅DEL指令支持，含，0表示不限]
+    bool is_dry_run;        // 仅统计待删除数量[仅DEL指令支持]
+    uint64_t *staff_ids;    // 多个工号[仅GET指令支持，按MEM_RESULT分类申请]
+    uint64_t id_count;      // 工号数量
+    query_priority_t priority;  // 请求优先级
+    bool is_remote;         // 远程请求标志[远程请求不得读取服务端文件]
 } query_info_t;
 
 typedef void (*execute_func_t)(query_info_t *, user_request_t *);  // 执行指令函数指针
@@ -97,6 +178,20 @@ typedef struct{
 
 extern command_info_t g_cmd_infos[];
 
+void acquire_command_gate(gate_mode_t mode);
+void release_command_gate(void);
+void get_command_gate_stat(gate_mode_t mode, gate_stat_t *stat);
+query_priority_t classify_query_priority(const query_info_t *query);
 void execute_input_command(query_info_t *query, user_request_t *request);
+char *reserve_request_result(user_request_t *request, size_t size);
+void commit_request_result(user_request_t *request, size_t size);
+void append_request_text(user_request_t *request, const char *text, size_t length);
+void append_request_result(user_request_t *request, const char *format, ...) __attribute__((format(printf, 2, 3)));
+void set_request_result(user_request_t *request, const char *format, ...) __attribute__((format(printf, 2, 3)));
+const char *get_request_result(const user_request_t *request);
+size_t get_request_result_length(const user_request_t *request);
+void clear_request_result(user_request_t *request);
+void fail_command_batch(uint8_t input_fd);
+void clear_command_batch(uint8_t input_fd);
 
 #endif /* command_execution_h */
\ No newline at end of file
@@ -8,12 +8,33 @@
 #include "command_parser.h"
 #include "common.h"
 #include "log.h"
+#include "mem_stat.h"
 #include <time.h>
 #include <ctype.h>
 
 static const uint8_t max_input_params = 32;     // 最多输入参数组
 static const char sort_flag[] = "--sort:";      // 排序标识
+static const char sort_separators[] = ",";      // 排序字段分隔符
+static const char asc_flag[] = "asc";           // 升序标识
+static const char desc_flag[] = "desc";         // 降序标识
 static const char global_flag[] = "*";          // 全局操作标识
+static const char format_flag[] = "--format:";  // 导出格式标识
+static const char file_flag[] = "--file:";      // 导出路径标识
+static const char group_flag[] = "--group:";    // 分组标识
+static const char limit_flag[] = "--limit:";    // 分页数量标识
+static const char offset_flag[] = "--offset:";  // 分页偏移标识
+static const char prefix_flag[] = "name~:";     // 姓名前缀标识
+static const char substr_flag[] = "name%:";     // 姓名子串标识
+static const char fuzzy_flag[] = "name?:";      // 姓名模糊匹配标识
+static const char distance_flag[] = "--dist:";  // 最大编辑距离标识
+static const char from_flag[] = "--from:";      // 入职日期下限标识
+static const char to_flag[] = "--to:";          // 入职日期上限标识
+static const char dry_flag[] = "--dry";         // 试运行标识
+static const char ids_flag[] = "--ids:";        // 工号文件标识
+static const char id_separators[] = ", \t\r\n";  // 工号列表分隔符
+static const uint32_t max_ids_file_size = 1 << 24;  // 工号文件大小上限
+static const uint8_t default_edit_distance = 2; // 默认最大编辑距离
+static const uint8_t max_edit_distance = 4;     // 最大编辑距离上限
 
 /**
 * @brief 信息类型描述
@@ -32,6 +53,26 @@ static const char *info_type_str[] = {
 static const char *sort_type_str[] = {
     [SORT_ID]   = "id",
     [SORT_DATE] = "date",
+    [SORT_NAME] = "name",
+    [SORT_DEPT] = "dept",
+    [SORT_POS]  = "pos",
+};
+
+/**
+* @brief 分组方式描述
+*/
+static const char *group_type_str[] = {
+    [GROUP_DEPT] = "dept",
+    [GROUP_POS]  = "pos",
+    [GROUP_YEAR] = "year",
+};
+
+/**
+* @brief 导出格式描述
+*/
+static const char *export_format_str[] = {
+    [EXPORT_CSV]    = "csv",
+    [EXPORT_JSONL]  = "jsonl",
 };
 
 /**
@@ -187,20 +228,86 @@ STATIC bool is_name_valid(const char *string) {
 }
 
 /**
- * @brief           解析排序方式
+ * @brief           解析排序字段
+ * @param string    待解析字符串
+ * @return          排序字段
+ */
+static sort_type_t parse_sort_type(const char *string) {
+    for (sort_type_t i = SORT_NONE + 1; i < SORT_MAX; i++) {
+        if (strcmp(string, sort_type_str[i]) == 0) {
+            return i;
+        }
+    }
+    return SORT_NONE;
+}
+
+/**
+ * @brief           解析排序规则[--sort:字段[:asc|desc],...，按输入顺序确定优先级，各字段最多出现一次]
  * @param string    待解析字符串
- * @return          排序方式
+ * @param order     存放地址
+ * @return          false表示解析失败，否则为成功
  */
-STATIC sort_type_t parse_sort_type(const char *string) {
-    sort_type_t type = SORT_NONE;
-    uint8_t begin = strlen(sort_flag);
+STATIC bool parse_sort_order(const char *string, sort_order_t *order) {
+    char fields[BUFSIZ] = {'\0'};
+    char *saved = NULL;
+    sort_order_t result;
 
     if (!is_string_prefix(string, sort_flag)) {
-        return SORT_NONE;
+        return false;
     }
-    for (sort_type_t i = SORT_NONE + 1; i < SORT_MAX; i++) {
-        if (strcmp(string+begin, sort_type_str[i]) == 0) {
-            LOG_C(LOG_DEBUG, "Sort by staff [%s].", sort_type_str[i])
+    bzero(&result, sizeof(sort_order_t));
+    snprintf(fields, BUFSIZ, "%s", string+strlen(sort_flag));
+    for (char *field = strtok_r(fields, sort_separators, &saved); field != NULL; field = strtok_r(NULL, sort_separators, &saved)) {
+        bool is_desc = false;
+        char *direction = strchr(field, ':');
+        if (direction != NULL) {
+            *direction++ = '\0';
+            is_desc = strcmp(direction, desc_flag) == 0;
+            if (!is_desc && strcmp(direction, asc_flag) != 0) {
+                LOG_C(LOG_ERROR, "Input sort direction [%s] is invalid.", direction)
+                return false;
+            }
+        }
+
+        sort_type_t type = parse_sort_type(field);
+        if (type == SORT_NONE || result.count == MAX_SORT_KEYS) {
+            LOG_C(LOG_ERROR, "Input sort field [%s] is invalid.", field)
+            return false;
+        }
+        for (uint8_t i = 0; i < result.count; i++) {
+            if (result.types[i] == type) {
+                LOG_C(LOG_ERROR, "Input sort field [%s] is repeated.", field)
+                return false;
+            }
+        }
+        LOG_C(LOG_DEBUG, "Sort by staff [%s] in [%s] order.", field, is_desc ? desc_flag : asc_flag)
+        result.types[result.count] = type;
+        result.is_desc[result.count] = is_desc;
+        result.count++;
+    }
+
+    if (result.count == 0) {
+        return false;
+    }
+    *order = result;
+    return true;
+}
+
+/**
+ * @brief           解析分组方式
+ * @param string    待解析字符串
+ * @return          分组方式
+ */
+STATIC group_type_t parse_group_type(const char *string) {
+    group_type_t type = GROUP_NONE;
+    uint8_t begin = strlen(group_flag);
+
+    if (!is_string_prefix(string, group_flag)) {
+        return GROUP_NONE;
+    }
+    for (group_type_t i = GROUP_NONE + 1; i < GROUP_MAX; i++) {
+        if (strcmp(string+begin, group_type_str[i]) == 0) {
+            LOG_C(LOG_DEBUG, "Group by staff [%s].", group_type_str[i])
             type = i;
             break;
         }
@@ -209,6 +316,176 @@ STATIC sort_type_t parse_sort_type(const char *string) {
     return type;
 }
 
+/**
+ * @brief           解析非负整数
+ * @param string    待解析字符串
+ * @param number    解析结果
+ * @return          false表示解析失败，否则为成功
+ */
+static bool parse_number(const char *string, uint64_t *number) {
+    char *end = NULL;
+    if (string[0] < '0' || string[0] > '9') {
+        return false;
+    }
+    *number = strtoull(string, &end, 10);
+    return *end == '\0';
+}
+
+/**
+ * @brief               解析分页选项[数量须大于0]
+ * @param string        待解析字符串
+ * @param query_info    存放地址
+ * @return              false表示解析失败，否则为成功
+ */
+STATIC bool parse_page_option(const char *string, query_info_t *query_info) {
+    if (is_string_prefix(string, limit_flag)) {
+        if (!parse_number(string+strlen(limit_flag), &query_info->limit) || query_info->limit == 0) {
+            LOG_C(LOG_ERROR, "Input limit is invalid.")
+            return false;
+        }
+        return true;
+    }
+    if (is_string_prefix(string, offset_flag)) {
+        if (!parse_number(string+strlen(offset_flag), &query_info->offset)) {
+            LOG_C(LOG_ERROR, "Input offset is invalid.")
+            return false;
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief               解析导出选项[格式或路径，各最多输入一次]
+ * @param string        待解析字符串
+ * @param query_info    存放地址
+ * @return              false表示解析失败，否则为成功
+ */
+STATIC bool parse_export_option(const char *string, query_info_t *query_info) {
+    if (is_string_prefix(string, format_flag)) {
+        const char *format = string + strlen(format_flag);
+        for (export_format_t i = EXPORT_CSV; i < EXPORT_MAX; i++) {
+            if (strcmp(format, export_format_str[i]) == 0) {
+                LOG_C(LOG_DEBUG, "Export format is [%s].", export_format_str[i])
+                query_info->export_format = i;
+                return true;
+            }
+        }
+        return false;
+    }
+    if (is_string_prefix(string, file_flag) && query_info->export_path == NULL) {
+        size_t begin = strlen(file_flag);
+        size_t size = strlen(string);
+        if (size <= begin) {
+            return false;
+        }
+        query_info->export_path = mem_strndup(MEM_STRING, string+begin, size-begin);
+        LOG_C(LOG_DEBUG, "Export file is [%s].", query_info->export_path)
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief               解析最大编辑距离[取值1至max_edit_distance]
+ * @param string        待解析字符串
+ * @param query_info    存放地址
+ * @return              false表示解析失败，否则为成功
+ */
+STATIC bool parse_distance_option(const char *string, query_info_t *query_info) {
+    uint64_t distance = 0;
+    if (!is_string_prefix(string, distance_flag)) {
+        return false;
+    }
+    if (!parse_number(string+strlen(distance_flag), &distance) || distance == 0 || distance > max_edit_distance) {
+        LOG_C(LOG_ERROR, "Input edit distance is invalid.")
+        return false;
+    }
+    query_info->max_distance = (uint8_t)distance;
+    return true;
+}
+
+/**
+ * @brief               解析入职日期区间或试运行标志[可重复输入，以最后输入为准]
+ * @param string        待解析字符串
+ * @param query_info    存放地址
+ * @return              false表示解析失败，否则为成功
+ */
+STATIC bool parse_range_option(const char *string, query_info_t *query_info) {
+    uint64_t *date = NULL;
+    size_t begin = 0;
+    if (strcmp(string, dry_flag) == 0) {
+        query_info->is_dry_run = true;
+        return true;
+    }
+    if (is_string_prefix(string, from_flag)) {
+        date = &query_info->date_from;
+        begin = strlen(from_flag);
+    }
+    else if (is_string_prefix(string, to_flag)) {
+        date = &query_info->date_to;
+        begin = strlen(to_flag);
+    }
+    else {
+        return false;
+    }
+
+    *date = (uint64_t)date_to_second(string+begin);
+    if (*date == 0) {
+        LOG_C(LOG_ERROR, "Input date range is invalid.")
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief               判断删除范围是否明确[须指定工号、全局标志或至少一项过滤条件]
+ * @param query_info    查询信息
+ * @return              false表示未指定范围，否则为已指定
+ */
+static bool is_delete_scoped(const query_info_t *query_info) {
+    const staff_info_t *info = &query_info->info;
+    return query_info->is_opt_all || info->staff_id != 0 || info->name != NULL || info->department != NULL ||
+        info->position != NULL || info->date != 0 || query_info->date_from != 0 || query_info->date_to != 0;
+}
+
+/**
+ * @brief               解析姓名前缀、子串或模糊匹配[可重复输入，以最后输入为准]
+ * @param string        待解析字符串
+ * @param query_info    存放地址
+ * @return              false表示解析失败，否则为成功
+ */
+STATIC bool parse_name_pattern(const char *string, query_info_t *query_info) {
+    name_match_t match = NAME_EXACT;
+    size_t begin = 0;
+    if (is_string_prefix(string, prefix_flag)) {
+        match = NAME_PREFIX;
+        begin = strlen(prefix_flag);
+    }
+    else if (is_string_prefix(string, substr_flag)) {
+        match = NAME_SUBSTR;
+        begin = strlen(substr_flag);
+    }
+    else if (is_string_prefix(string, fuzzy_flag)) {
+        match = NAME_FUZZY;
+        begin = strlen(fuzzy_flag);
+    }
+    else {
+        return false;
+    }
+
+    size_t size = strlen(string);
+    if (size <= begin || !is_name_valid(string+begin)) {
+        LOG_C(LOG_ERROR, "Input name pattern is invalid.")
+        return false;
+    }
+    MEM_FREE(MEM_STRING, query_info->info.name)
+    query_info->info.name = mem_strndup(MEM_STRING, string+begin, size-begin);
+    query_info->name_match = match;
+    LOG_C(LOG_DEBUG, "Name pattern is [%s].", query_info->info.name)
+    return true;
+}
+
 /**
  * @brief           解析日志等级
  * @param string    待解析字符串
@@ -268,7 +545,8 @@ STATIC bool parse_staff_info(const char *string, staff_info_t *info) {
     
     switch (type) {
         case INFO_ID:
-            info->staff_id = atoi(string+end);
+            // 逗号分隔的多个工号由parse_id_list解析，此处不截取首个工号
+            info->staff_id = strchr(string+end, ',') == NULL ? atoi(string+end) : 0;
             if (info->staff_id == 0) {
                 LOG_C(LOG_ERROR, "Input staff id is invalid.")
                 return false;
@@ -280,7 +558,7 @@ STATIC bool parse_staff_info(const char *string, staff_info_t *info) {
                 LOG_C(LOG_ERROR, "Input name is invalid.")
                 return false;
             }
-            info->name = strndup(string+end, size-end);
+            info->name = mem_strndup(MEM_STRING, string+end, size-end);
             break;
         case INFO_DATE:
             info->date = (uint64_t)date_to_second(string+end);
@@ -290,10 +568,10 @@ STATIC bool parse_staff_info(const char *string, staff_info_t *info) {
             }
             break;
         case INFO_DEPT:
-            info->department = strndup(string+end, size-end);
+            info->department = mem_strndup(MEM_STRING, string+end, size-end);
             break;
         case INFO_POS:
-            info->position = strndup(string+end, size-end);
+            info->position = mem_strndup(MEM_STRING, string+end, size-end);
             break;
             
         default:
@@ -303,6 +581,114 @@ STATIC bool parse_staff_info(const char *string, staff_info_t *info) {
     return true;
 }
 
+/**
+ * @brief               追加工号[数量为2的幂时倍增扩容，无需单独记录容量]
+ * @param query_info    存放地址
+ * @param staff_id      工号
+ * @return              false表示失败，否则为成功
+ */
+static bool append_staff_id(query_info_t *query_info, uint64_t staff_id) {
+    uint64_t count = query_info->id_count;
+    if ((count & (count - 1)) == 0) {
+        uint64_t capacity = count < 16 ? 16 : count * 2;
+        uint64_t *ids = mem_realloc(MEM_RESULT, query_info->staff_ids, capacity * sizeof(uint64_t));
+        if (ids == NULL) {
+            LOG_C(LOG_ERROR, "Failed to realloc resources for staff ids.")
+            return false;
+        }
+        query_info->staff_ids = ids;
+    }
+    query_info->staff_ids[query_info->id_count++] = staff_id;
+    return true;
+}
+
+/**
+ * @brief               解析分隔符分割的工号列表
+ * @param string        待解析字符串
+ * @param query_info    存放地址
+ * @return              false表示解析失败，否则为成功
+ */
+static bool parse_id_tokens(const char *string, query_info_t *query_info) {
+    const char *current = string;
+    while (*current != '\0') {
+        if (strchr(id_separators, *current) != NULL) {
+            current++;
+            continue;
+        }
+        char *end = NULL;
+        uint64_t staff_id = 0;
+        if (*current >= '0' && *current <= '9') {
+            staff_id = strtoull(current, &end, 10);
+        }
+        if (staff_id == 0 || (*end != '\0' && strchr(id_separators, *end) == NULL)) {
+            LOG_C(LOG_ERROR, "Input staff id list is invalid.")
+            return false;
+        }
+        if (!append_staff_id(query_info, staff_id)) {
+            return false;
+        }
+        current = end;
+    }
+    return true;
+}
+
+/**
+ * @brief               解析工号文件[文本格式，工号以逗号或空白分隔]
+ * @param path          文件路径
+ * @param query_info    存放地址
+ * @return              false表示解析失败，否则为成功
+ */
+static bool parse_id_file(const char *path, query_info_t *query_info) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        LOG_C(LOG_ERROR, "Failed to open staff id file [%s].", path)
+        return false;
+    }
+
+    bool is_parsed = false;
+    char *content = NULL;
+    long size = 0;
+    if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 || size > max_ids_file_size || fseek(file, 0, SEEK_SET) != 0) {
+        LOG_C(LOG_ERROR, "Staff id file [%s] is invalid or too large.", path)
+        goto END;
+    }
+    content = mem_malloc(MEM_RESULT, size + 1);
+    if (content == NULL || fread(content, 1, size, file) != (size_t)size) {
+        goto END;
+    }
+    content[size] = '\0';
+    is_parsed = parse_id_tokens(content, query_info);
+
+END:
+    MEM_FREE(MEM_RESULT, content)
+    fclose(file);
+    return is_parsed;
+}
+
+/**
+ * @brief               解析多个工号[id:后以逗号分隔，或--ids:指定服务端工号文件(仅本地控制台)；可重复输入，依次追加]
+ * @param string        待解析字符串
+ * @param query_info    存放地址
+ * @return              false表示解析失败或非多工号参数，否则为成功
+ */
+STATIC bool parse_id_list(const char *string, query_info_t *query_info) {
+    if (is_string_prefix(string, ids_flag)) {
+        // 远程客户端不得读取服务端文件
+        if (query_info->is_remote) {
+            LOG_C(LOG_ERROR, "Staff id file is only allowed from local console.")
+            return false;
+        }
+        size_t begin = strlen(ids_flag);
+        return strlen(string) > begin && parse_id_file(string+begin, query_info);
+    }
+
+    size_t end = 0;
+    if (parse_info_type(string, &end) != INFO_ID || strchr(string+end, ',') == NULL) {
+        return false;
+    }
+    return parse_id_tokens(string+end, query_info);
+}
+
 /**
  * @brief           解析输入指令
  * @param string    待解析字符串
@@ -311,7 +697,7 @@ STATIC bool parse_staff_info(const char *string, staff_info_t *info) {
 STATIC user_command_t parse_input_command(const char *string) {
     user_command_t command = CMD_NUL;
     size_t size = strlen(string);
-    char *input = strndup(string, size);
+    char *input = mem_strndup(MEM_STRING, string, size);
     // 指令大小写不敏感
     string_to_upper(input);
 
@@ -323,7 +709,7 @@ STATIC user_command_t parse_input_command(const char *string) {
         }
     }
 
-    FREE(input)
+    MEM_FREE(MEM_STRING, input)
     return command;
 }
 
@@ -340,8 +726,7 @@ STATIC bool parse_input_params(const char params[][BUFSIZ], uint8_t count, query
     for (uint8_t i = 0; i < count; ++i) {
         // 检查是否为排序标志[最多输入一次]
         if (param_type & INPUT_SORT) {
-            query_info->sort_type = parse_sort_type(params[i]);
-            if (query_info->sort_type != SORT_NONE) {
+            if (parse_sort_order(params[i], &query_info->sort_order)) {
                 param_type ^= INPUT_SORT;   // 不允许重复输入
                 continue;
             }
@@ -354,6 +739,44 @@ STATIC bool parse_input_params(const char params[][BUFSIZ], uint8_t count, query
                 continue;
             }
         }
+        // 检查是否为分组标志[最多输入一次]
+        if (param_type & INPUT_GROUP) {
+            query_info->group_type = parse_group_type(params[i]);
+            if (query_info->group_type != GROUP_NONE) {
+                param_type ^= INPUT_GROUP;  // 不允许重复输入
+                continue;
+            }
+        }
+        // 检查是否为分页选项
+        if (param_type & INPUT_PAGE) {
+            if (parse_page_option(params[i], query_info)) {
+                continue;
+            }
+        }
+        // 检查是否为姓名前缀、子串、模糊匹配或编辑距离
+        if (param_type & INPUT_PATTERN) {
+            if (parse_name_pattern(params[i], query_info) || parse_distance_option(params[i], query_info)) {
+                continue;
+            }
+        }
+        // 检查是否为多个工号
+        if (param_type & INPUT_IDS) {
+            if (parse_id_list(params[i], query_info)) {
+                continue;
+            }
+        }
+        // 检查是否为日期区间或试运行标志
+        if (param_type & INPUT_RANGE) {
+            if (parse_range_option(params[i], query_info)) {
+                continue;
+            }
+        }
+        // 检查是否为导出选项
+        if (param_type & INPUT_EXPORT) {
+            if (parse_export_option(params[i], query_info)) {
+                continue;
+            }
+        }
         // 检查是否为日志标志[最多输入一次]
         if (param_type & INPUT_LOG) {
             if (parse_log_level(params[i])) {
@@ -376,6 +799,17 @@ STATIC bool parse_input_params(const char params[][BUFSIZ], uint8_t count, query
     if (param_type & INPUT_ID && query_info->info.staff_id == 0) {
         return false;
     }
+    if (query_info->date_from != 0 && query_info->date_to != 0 && query_info->date_from > query_info->date_to) {
+        LOG_C(LOG_ERROR, "Input date range is empty.")
+        return false;
+    }
+    // 未指定任何条件的删除视为误输入，避免清空数据库
+    if (query_info->command == CMD_DEL && !is_delete_scoped(query_info)) {
+        return false;
+    }
+    if (query_info->name_match == NAME_FUZZY && query_info->max_distance == 0) {
+        query_info->max_distance = default_edit_distance;
+    }
 
     return true;
 }
@@ -383,9 +817,10 @@ STATIC bool parse_input_params(const char params[][BUFSIZ], uint8_t count, query
 /**
  * @brief               处理用户请求
  * @param input_request 用户请求信息
+ * @param input_fd      输入描述符[0-stdin, >0-remote]
  * @param query_info    待填充解析信息
  */
-bool parse_user_input(const char *input_request, query_info_t *query_info) {
+bool parse_user_input(const char *input_request, uint8_t input_fd, query_info_t *query_info) {
     if (input_request == NULL || query_info == NULL) {
         return false;
     }
@@ -394,6 +829,7 @@ bool parse_user_input(const char *input_request, query_info_t *query_info) {
     uint8_t param_cnt = 0;                          // 数组大小
     bzero(params, max_input_params*BUFSIZ);
     bzero(query_info, sizeof(query_info_t));
+    query_info->is_remote = input_fd != STDIN_FILENO;
     
     // 获取分割参数
     param_cnt = get_split_params(input_request, params);
@@ -406,6 +842,7 @@ bool parse_user_input(const char *input_request, query_info_t *query_info) {
     if (!parse_input_params(params+1, param_cnt-1, query_info)) {
         return false;
     }
+    query_info->priority = classify_query_priority(query_info);
 
     return true;
 }
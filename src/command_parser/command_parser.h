@@ -14,6 +14,6 @@
 #include <stdbool.h>
 #include <string.h>
 
-bool parse_user_input(const char *input_request, query_info_t *query_info);
+bool parse_user_input(const char *input_request, uint8_t input_fd, query_info_t *query_info);
 
 #endif /* command_parser_h */
@@ -9,9 +9,20 @@
 #define common_h
 
 #include <stdlib.h>
+#include <stdint.h>
 #include <stdbool.h>
+#include <time.h>
+#include <sys/socket.h>
+#ifndef __cplusplus
+#include <stdatomic.h>
+#endif
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0  // macOS通过SO_NOSIGPIPE屏蔽SIGPIPE
+#endif
 
 static const uint8_t time_str_size = 20;        // 时间字符串长度
+static const char result_end_flag = '\0';       // 远程结果结束标识[结果可能分多次发送]
 #define FREE(ptr)   if (ptr != NULL) {free(ptr); ptr = NULL;}
 
 /**
@@ -25,4 +36,48 @@ typedef struct {
     char *position;         // 职位
 } staff_info_t;
 
+/**
+ * @brief 分组统计方式
+ */
+typedef enum {
+    GROUP_NONE, // 不分组
+    GROUP_DEPT, // 按部门分组
+    GROUP_POS,  // 按职位分组
+    GROUP_YEAR, // 按入职年份分组
+    GROUP_MAX
+} group_type_t;
+
+/**
+ * @brief 姓名匹配方式
+ */
+typedef enum {
+    NAME_EXACT,     // 精确匹配
+    NAME_PREFIX,    // 前缀匹配
+    NAME_SUBSTR,    // 子串匹配
+    NAME_FUZZY,     // 模糊匹配[限定最大编辑距离]
+    NAME_MAX
+} name_match_t;
+
+/**
+ * @brief   获取单调时钟
+ * @return  纳秒时间戳
+ */
+static inline uint64_t get_monotonic_ns(void) {
+    struct timespec now = {0};
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+#ifndef __cplusplus
+/**
+ * @brief           原子更新最大值[并发更新时保留最大者]
+ * @param maximum   最大值
+ * @param value     新值
+ */
+static inline void update_atomic_maximum(atomic_uint_fast64_t *maximum, uint64_t value) {
+    uint64_t current = atomic_load(maximum);
+    while (value > current && !atomic_compare_exchange_weak(maximum, &current, value));
+}
+#endif
+
 #endif /* common_h */
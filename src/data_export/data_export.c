@@ -0,0 +1,205 @@
+//
+//  data_export.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "data_export.h"
+#include "text_format.h"
+#include "log.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+static const char csv_header[] = "staff_id,name,date,department,position\n";  // CSV表头
+
+/**
+ * @brief           写出当前分块
+ * @param writer    导出写入器
+ * @return          false表示失败，否则为成功
+ */
+STATIC bool flush_export_chunk(export_writer_t *writer) {
+    size_t offset = 0;
+    while (!writer->is_failed && offset < writer->length) {
+        ssize_t size = writer->is_socket ?
+            send(writer->output_fd, writer->chunk+offset, writer->length-offset, MSG_NOSIGNAL) :
+            write(writer->output_fd, writer->chunk+offset, writer->length-offset);
+        if (size < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_C(LOG_ERROR, "Failed to write export chunk, errno is [%d].", errno)
+            writer->is_failed = true;
+            break;
+        }
+        offset += size;
+    }
+    writer->length = 0;
+    return !writer->is_failed;
+}
+
+/**
+ * @brief           追加数据至分块[分块写满则写出]
+ * @param writer    导出写入器
+ * @param data      待追加数据
+ * @param size      数据长度
+ */
+static void append_export_data(export_writer_t *writer, const char *data, size_t size) {
+    while (size > 0 && !writer->is_failed) {
+        size_t rest = BUFSIZ - writer->length;
+        size_t len = size < rest ? size : rest;
+        memcpy(writer->chunk+writer->length, data, len);
+        writer->length += len;
+        data += len;
+        size -= len;
+        if (writer->length == BUFSIZ) {
+            flush_export_chunk(writer);
+        }
+    }
+}
+
+/**
+ * @brief           追加单个字符至分块
+ * @param writer    导出写入器
+ * @param ch        待追加字符
+ */
+static inline void append_export_char(export_writer_t *writer, char ch) {
+    append_export_data(writer, &ch, 1);
+}
+
+/**
+ * @brief           追加CSV字段[含逗号、引号或换行时加引号转义]
+ * @param writer    导出写入器
+ * @param string    字段值[NULL输出空字段]
+ */
+static void append_csv_field(export_writer_t *writer, const char *string) {
+    if (string == NULL) {
+        return;
+    }
+    if (strpbrk(string, ",\"\r\n") == NULL) {
+        append_export_data(writer, string, strlen(string));
+        return;
+    }
+
+    append_export_char(writer, '"');
+    for (const char *ch = string; *ch != '\0'; ch++) {
+        if (*ch == '"') {
+            append_export_char(writer, '"');
+        }
+        append_export_char(writer, *ch);
+    }
+    append_export_char(writer, '"');
+}
+
+/**
+ * @brief           追加JSON字符串[转义引号、反斜杠及控制字符]
+ * @param writer    导出写入器
+ * @param string    字符串值[NULL输出null]
+ */
+static void append_json_string(export_writer_t *writer, const char *string) {
+    if (string == NULL) {
+        append_export_data(writer, "null", strlen("null"));
+        return;
+    }
+
+    char escape[8] = {'\0'};
+    append_export_char(writer, '"');
+    for (const char *ch = string; *ch != '\0'; ch++) {
+        if (*ch == '"' || *ch == '\\') {
+            append_export_char(writer, '\\');
+            append_export_char(writer, *ch);
+        }
+        else if ((unsigned char)*ch < 0x20) {
+            snprintf(escape, sizeof(escape), "\\u%04x", *ch);
+            append_export_data(writer, escape, strlen(escape));
+        }
+        else {
+            append_export_char(writer, *ch);
+        }
+    }
+    append_export_char(writer, '"');
+}
+
+/**
+ * @brief           初始化导出写入器
+ * @param writer    导出写入器
+ * @param output_fd 输出描述符
+ * @param format    导出格式
+ */
+void init_export_writer(export_writer_t *writer, int output_fd, export_format_t format) {
+    if (writer == NULL) {
+        return;
+    }
+
+    struct stat output_stat;
+    writer->output_fd = output_fd;
+    writer->is_socket = fstat(output_fd, &output_stat) == 0 && S_ISSOCK(output_stat.st_mode);
+    writer->format = format;
+    writer->is_failed = false;
+    writer->count = 0;
+    writer->length = 0;
+    if (format == EXPORT_CSV) {
+        append_export_data(writer, csv_header, strlen(csv_header));
+    }
+}
+
+/**
+ * @brief           导出指定员工信息[可作为数据库遍历回调]
+ * @param info      员工信息
+ * @param writer    导出写入器
+ * @return          false表示写出失败，否则为成功
+ */
+bool export_a_staff(const staff_info_t *info, void *writer) {
+    export_writer_t *export_writer = (export_writer_t *)writer;
+    if (info == NULL || export_writer == NULL) {
+        return false;
+    }
+
+    char id_str[UINT64_TEXT_SIZE + 1] = {'\0'};
+    char date_str[DATE_TEXT_SIZE + 1] = {'\0'};
+    size_t id_len = format_uint64(id_str, info->staff_id);
+    format_date(date_str, info->date);
+
+    if (export_writer->format == EXPORT_JSONL) {
+        append_export_data(export_writer, "{\"staff_id\":", strlen("{\"staff_id\":"));
+        append_export_data(export_writer, id_str, id_len);
+        append_export_data(export_writer, ",\"name\":", strlen(",\"name\":"));
+        append_json_string(export_writer, info->name);
+        append_export_data(export_writer, ",\"date\":", strlen(",\"date\":"));
+        append_json_string(export_writer, date_str);
+        append_export_data(export_writer, ",\"department\":", strlen(",\"department\":"));
+        append_json_string(export_writer, info->department);
+        append_export_data(export_writer, ",\"position\":", strlen(",\"position\":"));
+        append_json_string(export_writer, info->position);
+        append_export_data(export_writer, "}\n", strlen("}\n"));
+    }
+    else {
+        append_export_data(export_writer, id_str, id_len);
+        append_export_char(export_writer, ',');
+        append_csv_field(export_writer, info->name);
+        append_export_char(export_writer, ',');
+        append_csv_field(export_writer, date_str);
+        append_export_char(export_writer, ',');
+        append_csv_field(export_writer, info->department);
+        append_export_char(export_writer, ',');
+        append_csv_field(export_writer, info->position);
+        append_export_char(export_writer, '\n');
+    }
+    export_writer->count++;
+
+    return !export_writer->is_failed;
+}
+
+/**
+ * @brief           结束导出，写出剩余分块
+ * @param writer    导出写入器
+ * @return          false表示导出过程中写出失败，否则为成功
+ */
+bool finish_export(export_writer_t *writer) {
+    if (writer == NULL) {
+        return false;
+    }
+    return flush_export_chunk(writer);
+}
@@ -0,0 +1,32 @@
+//
+//  data_export.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef data_export_h
+#define data_export_h
+
+#include "command_execution.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+/**
+ * @brief 导出写入器[按BUFSIZ分块写出，不缓存完整结果]
+ */
+typedef struct {
+    int output_fd;          // 输出描述符[文件或套接字]
+    bool is_socket;         // 输出至套接字[对端关闭时不产生SIGPIPE]
+    export_format_t format; // 导出格式
+    bool is_failed;         // 写出失败标志
+    uint64_t count;         // 已导出员工数量
+    size_t length;          // 当前分块已用长度
+    char chunk[BUFSIZ];     // 当前分块
+} export_writer_t;
+
+void init_export_writer(export_writer_t *writer, int output_fd, export_format_t format);
+bool export_a_staff(const staff_info_t *info, void *writer);
+bool finish_export(export_writer_t *writer);
+
+#endif /* data_export_h */
@@ -1,50 +1,203 @@
 #include "database_manager.h"
 #include "hash_table.h"
+#include "bloom_filter.h"
+#include "thread_pool.h"
+#include "name_index.h"
 #include "log.h"
+#include "mem_stat.h"
+#include <time.h>
 #include <string.h>
+#include <unistd.h>
 
-static const uint16_t default_table_size = 1024;    // 默认哈希表容量
-static hash_table_t *s_hash_table = NULL;           // 哈希表
+#define MAX_SHARD_COUNT     64                      // 最大分片数量
+
+static const uint16_t default_table_size = 1024;    // 默认哈希表容量[所有分片合计]
+static const uint16_t min_shard_size = 64;          // 单分片最小哈希表容量
+static const uint16_t default_group_size = 64;      // 默认分组计数表容量
+static const uint16_t min_range_buckets = 256;      // 扫描任务最少桶数量[避免切分过细]
+static const uint8_t tasks_per_thread = 4;          // 每个扫描线程平均任务数[均衡各区间匹配数量差异]
+static const uint8_t prefetch_distance = 8;         // 批量查找预取距离[桶预取距离加倍，首结点预取距离为该值]
+static const char null_group[] = "(null)";          // 信息缺失时所属分组
+static hash_table_t *s_shards[MAX_SHARD_COUNT] = {NULL};    // 分片哈希表[按工号哈希分片]
+static uint32_t s_shard_count = 0;                  // 分片数量
+static uint32_t s_config_shard_count = 0;           // 配置分片数量[0表示使用CPU核数]
+static thread_pool_t *s_shard_pool = NULL;          // 扫描线程池[线程数取CPU核数与分片数较大者，随进程存在]
+static hash_table_t *s_group_tables[GROUP_MAX] = {NULL};    // 分组计数表[随增删改增量维护]
+static uint64_t s_data_version = 1;                 // 数据版本[每次变更递增，用于缓存失效]
+static bloom_filter_t *s_id_filter = NULL;          // 工号过滤器[一定不存在的工号无需查找哈希表]
+static bool s_is_filter_enabled = true;             // 是否启用工号过滤器
+static change_staff_callback s_change_func = NULL;  // 员工变更回调[用于缓存失效]
+
+/**
+ * @brief 分片扫描任务[扫描分片内一段桶区间]
+ */
+typedef struct {
+    hash_table_t *table;            // 分片哈希表
+    uint64_t begin;                 // 起始桶序号
+    uint64_t end;                   // 结束桶序号[不含]
+    staff_info_t *info;             // 匹配信息
+    staff_info_t **items;           // 区间匹配结果
+    uint64_t count;                 // 区间匹配数量
+} shard_scan_t;
+
+/**
+ * @brief 紧凑员工记录[信息与字符串一次申请，字符串依次存放于尾部，修改后放不下的字符串改存堆上]
+ */
+typedef struct {
+    staff_info_t info;      // 员工信息[须为首成员，哈希表存储及对外返回均为该地址]
+    uint32_t tail_size;     // 尾部容量
+    char tail[];            // 字符串尾部
+} staff_record_t;
+
+/**
+ * @brief 遍历回调上下文
+ */
+typedef struct {
+    traverse_staff_callback func;   // 调用方回调
+    void *context;                  // 调用方上下文
+    const char *pattern;            // 姓名查询串[NULL表示不按姓名过滤]
+    name_match_t match;             // 姓名匹配方式
+    uint8_t distance;               // 最大编辑距离[仅模糊匹配使用]
+} traverse_context_t;
+
+/**
+ * @brief 批量删除上下文
+ */
+typedef struct {
+    uint64_t date_from;             // 入职日期下限[含，0表示不限]
+    uint64_t date_to;               // 入职日期上限[含，0表示不限]
+    bool is_dry_run;                // 仅统计数量，不删除
+    traverse_staff_callback func;   // 删除前回调[可为NULL]
+    void *context;                  // 回调上下文
+    uint64_t count;                 // 匹配数量
+} remove_context_t;
+
+/**
+ * @brief           判断字符串是否存放于记录尾部
+ * @param record    员工记录
+ * @param string    字符串
+ * @return          false表示存放于堆上，否则为记录尾部
+ */
+static inline bool is_inline_string(const staff_record_t *record, const char *string) {
+    return string >= record->tail && string < record->tail + record->tail_size;
+}
+
+/**
+ * @brief           释放记录中存放于堆上的字符串
+ * @param record    员工记录
+ * @param string    字符串地址
+ */
+static inline void free_record_string(const staff_record_t *record, char **string) {
+    if (*string != NULL && !is_inline_string(record, *string)) {
+        MEM_FREE(MEM_STRING, *string)
+    }
+    *string = NULL;
+}
+
+/**
+ * @brief       创建紧凑员工记录[一次申请，字符串紧随信息存放]
+ * @param info  员工信息
+ * @return      NULL表示失败，否则为成功
+ */
+STATIC staff_record_t *create_record(const staff_info_t *info) {
+    const char *strings[] = {info->name, info->department, info->position};
+    size_t lengths[sizeof(strings) / sizeof(char *)] = {0};
+    size_t tail_size = 0;
+
+    for (size_t i = 0; i < sizeof(strings) / sizeof(char *); i++) {
+        if (strings[i] != NULL) {
+            lengths[i] = strlen(strings[i]) + 1;
+            tail_size += lengths[i];
+        }
+    }
+    staff_record_t *record = mem_malloc(MEM_RECORD, sizeof(staff_record_t) + tail_size);
+    if (record == NULL) {
+        LOG_C(LOG_ERROR, "Failed to malloc resources for staff record.")
+        return NULL;
+    }
+
+    char *fields[sizeof(strings) / sizeof(char *)] = {NULL};
+    char *tail = record->tail;
+    for (size_t i = 0; i < sizeof(strings) / sizeof(char *); i++) {
+        if (strings[i] != NULL) {
+            memcpy(tail, strings[i], lengths[i]);
+            fields[i] = tail;
+            tail += lengths[i];
+        }
+    }
+    record->info.staff_id = info->staff_id;
+    record->info.date = info->date;
+    record->info.name = fields[0];
+    record->info.department = fields[1];
+    record->info.position = fields[2];
+    record->tail_size = (uint32_t)tail_size;
+    return record;
+}
 
 /**
  * @brief       清理存储值
  * @param value 待清理值
  */
 STATIC void clear_value(void *value) {
-    staff_info_t *info = (staff_info_t *)value;
-    if (info != NULL) {
-        FREE(info->name)
-        FREE(info->position)
-        FREE(info->department)
-        FREE(info)
+    staff_record_t *record = (staff_record_t *)value;
+    if (record != NULL) {
+        free_record_string(record, &record->info.name);
+        free_record_string(record, &record->info.position);
+        free_record_string(record, &record->info.department);
+        MEM_FREE(MEM_RECORD, record)
+    }
+}
+
+/**
+ * @brief           更新记录中的字符串[与原值相同则跳过；原值位于尾部且新值不长于原值时原地覆盖，否则转移或拷贝至堆上]
+ * @param record    员工记录
+ * @param dst       待更新字符串地址
+ * @param src       新值地址[为空表示不修改，转移所有权后置空]
+ * @param is_move   是否转移新值所有权[新值须按MEM_STRING分类申请]
+ * @return          false表示未变更，否则为已变更
+ */
+static bool update_record_string(staff_record_t *record, char **dst, char **src, bool is_move) {
+    if (*src == NULL || (*dst != NULL && strcmp(*dst, *src) == 0)) {
+        return false;
+    }
+    size_t length = strlen(*src);
+    if (*dst != NULL && is_inline_string(record, *dst) && length <= strlen(*dst)) {
+        memmove(*dst, *src, length + 1);
+        return true;
+    }
+
+    char *string = is_move ? *src : mem_strndup(MEM_STRING, *src, length);
+    if (string == NULL) {
+        LOG_C(LOG_ERROR, "Failed to strndup resources for staff record.")
+        return false;
     }
+    free_record_string(record, dst);
+    *dst = string;
+    if (is_move) {
+        *src = NULL;
+    }
+    return true;
 }
 
 /**
- * @brief       拷贝存储值
+ * @brief       拷贝存储值[记录地址不变]
  * @param dst   拷贝至
  * @param src   拷贝于
  */
 STATIC void copy_value(void *dst, const void *src) {
+    staff_record_t *dst_record = (staff_record_t *)dst;
     staff_info_t *dst_value = (staff_info_t *)dst;
     staff_info_t *src_value = (staff_info_t *)src;
 
     if (dst_value != NULL && src_value != NULL) {
         dst_value->staff_id = src_value->staff_id;
-        dst_value->date = src_value->date;
-
-        if (src_value->name != NULL) {
-            FREE(dst_value->name)
-            dst_value->name = strndup(src_value->name, strlen(src_value->name));
-        }
-        if (src_value->position != NULL) {
-            FREE(dst_value->position)
-            dst_value->position = strndup(src_value->position, strlen(src_value->position));
-        }
-        if (src_value->department != NULL) {
-            FREE(dst_value->department)
-            dst_value->department = strndup(src_value->department, strlen(src_value->department));
+        // 日期为0表示未指定，保留原值
+        if (src_value->date != 0) {
+            dst_value->date = src_value->date;
         }
+        update_record_string(dst_record, &dst_value->name, &src_value->name, false);
+        update_record_string(dst_record, &dst_value->position, &src_value->position, false);
+        update_record_string(dst_record, &dst_value->department, &src_value->department, false);
     }
 }
 
@@ -101,21 +254,292 @@ STATIC bool is_value_equal(const void *src, const void *dst) {
 }
 
 /**
- * @brief   创建数据库
+ * @brief       清理分组计数
+ * @param value 待清理值
+ */
+STATIC void clear_group_value(void *value) {
+    group_count_t *group = (group_count_t *)value;
+    if (group != NULL) {
+        MEM_FREE(MEM_INDEX, group->value)
+        MEM_FREE(MEM_INDEX, group)
+    }
+}
+
+/**
+ * @brief       拷贝分组计数
+ * @param dst   拷贝至
+ * @param src   拷贝于
+ */
+STATIC void copy_group_value(void *dst, const void *src) {
+    group_count_t *dst_group = (group_count_t *)dst;
+    group_count_t *src_group = (group_count_t *)src;
+
+    if (dst_group != NULL && src_group != NULL) {
+        dst_group->count = src_group->count;
+        if (src_group->value != NULL) {
+            MEM_FREE(MEM_INDEX, dst_group->value)
+            dst_group->value = mem_strndup(MEM_INDEX, src_group->value, strlen(src_group->value));
+        }
+    }
+}
+
+/**
+ * @brief       比较分组值是否相同
+ * @param src   分组1
+ * @param dst   分组2
+ * @return      false表示不同，否则为相同
+ */
+STATIC bool is_group_equal(const void *src, const void *dst) {
+    group_count_t *src_group = (group_count_t *)src;
+    group_count_t *dst_group = (group_count_t *)dst;
+
+    if (src_group == NULL || dst_group == NULL) {
+        return false;
+    }
+    return is_string_equal(src_group->value, dst_group->value);
+}
+
+/**
+ * @brief       计算分组值哈希[FNV-1a，结果非0]
+ * @param value 分组值
+ * @return      哈希值
+ */
+static uint64_t hash_group_value(const char *value) {
+    uint64_t hash = 14695981039346656037UL;
+    for (const char *ch = value; *ch != '\0'; ch++) {
+        hash ^= (uint8_t)*ch;
+        hash *= 1099511628211UL;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+/**
+ * @brief           获取员工所属分组值
+ * @param info      员工信息
+ * @param type      分组方式
+ * @param buffer    年份字符串缓存
+ * @param size      缓存大小
+ * @return          分组值
+ */
+static const char *get_group_value(const staff_info_t *info, group_type_t type, char *buffer, size_t size) {
+    const char *value = NULL;
+    struct tm time = {0};
+
+    switch (type) {
+        case GROUP_DEPT:
+            value = info->department;
+            break;
+        case GROUP_POS:
+            value = info->position;
+            break;
+        case GROUP_YEAR:
+            if (info->date != 0 && localtime_r((time_t *)&info->date, &time) != NULL) {
+                snprintf(buffer, size, "%d", time.tm_year + 1900);
+                value = buffer;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return value != NULL ? value : null_group;
+}
+
+/**
+ * @brief               更新指定分组计数
+ * @param type          分组方式
+ * @param value         分组值
+ * @param is_increase   true表示加1，否则为减1
+ */
+static void update_group_counter(group_type_t type, const char *value, bool is_increase) {
+    hash_table_t **table = &s_group_tables[type];
+    uint64_t key = hash_group_value(value);
+    group_count_t *group = NULL;
+
+    // 哈希冲突时线性探测下一主键[计数项归零后保留，保证探测链完整]
+    while ((group = (group_count_t *)get_item_by_key(*table, key)) != NULL) {
+        if (strcmp(group->value, value) == 0) {
+            break;
+        }
+        key = key + 1 == 0 ? 1 : key + 1;
+    }
+
+    if (group != NULL) {
+        if (is_increase) {
+            group->count++;
+        }
+        else if (group->count > 0) {
+            group->count--;
+        }
+        return;
+    }
+    if (is_increase) {
+        group_count_t new_group = {
+            .value = (char *)value,
+            .count = 1
+        };
+        add_item_to_table(table, key, &new_group, true);
+    }
+}
+
+/**
+ * @brief               更新员工所属的所有分组计数
+ * @param info          员工信息
+ * @param is_increase   true表示加1，否则为减1
+ */
+static void update_group_counters(const staff_info_t *info, bool is_increase) {
+    char buffer[time_str_size] = {'\0'};
+    for (group_type_t i = GROUP_NONE + 1; i < GROUP_MAX; i++) {
+        update_group_counter(i, get_group_value(info, i, buffer, time_str_size), is_increase);
+    }
+}
+
+/**
+ * @brief           获取工号所属分片
+ * @param staff_id  工号
+ * @return          分片哈希表地址
+ */
+static inline hash_table_t **get_shard_table(uint64_t staff_id) {
+    // 取混合后高位分片，避免与分片内桶哈希相关
+    uint64_t hash = (staff_id ^ (staff_id >> 31)) * 0xbf58476d1ce4e5b9UL;
+    return &s_shards[(hash >> 32) % s_shard_count];
+}
+
+/**
+ * @brief           添加工号至过滤器[过滤器遍历回调]
+ * @param value     员工信息
+ * @param context   过滤器
+ * @return          true表示继续遍历
+ */
+static bool add_id_to_filter(void *value, void *context) {
+    add_key_to_bloom_filter((bloom_filter_t *)context, ((staff_info_t *)value)->staff_id);
+    return true;
+}
+
+/**
+ * @brief 按当前员工数量两倍扩容工号过滤器并重新添加所有工号[均摊O(1)]
+ */
+STATIC void rebuild_id_filter(void) {
+    if (!resize_bloom_filter(s_id_filter, get_count_from_database() * 2)) {
+        return;
+    }
+    for (uint32_t i = 0; i < s_shard_count; i++) {
+        traverse_items_from_table(s_shards[i], NULL, add_id_to_filter, s_id_filter);
+    }
+}
+
+/**
+ * @brief           工号是否可能存在[过滤器未启用时总是可能存在]
+ * @param staff_id  工号
+ * @return          false表示一定不存在，否则可能存在
+ */
+static inline bool is_id_maybe_exist(uint64_t staff_id) {
+    return is_key_maybe_in_bloom_filter(s_id_filter, staff_id);
+}
+
+/**
+ * @brief       设置分片数量[下次创建数据库时生效]
+ * @param count 分片数量[0表示使用CPU核数]
+ */
+void set_database_shard_count(uint32_t count) {
+    s_config_shard_count = count > MAX_SHARD_COUNT ? MAX_SHARD_COUNT : count;
+}
+
+/**
+ * @brief               设置是否启用工号过滤器[下次创建数据库时生效]
+ * @param is_enabled    是否启用
+ */
+void set_database_id_filter(bool is_enabled) {
+    s_is_filter_enabled = is_enabled;
+}
+
+/**
+ * @brief       设置员工变更回调[修改或删除员工后调用]
+ * @param func  回调函数
+ */
+void set_database_change_callback(change_staff_callback func) {
+    s_change_func = func;
+}
+
+/**
+ * @brief   获取数据库扫描线程池[供大数组并行排序复用]
+ * @return  NULL表示未创建[单核且单分片]，否则为线程池
+ */
+thread_pool_t *get_database_thread_pool(void) {
+    return s_shard_pool;
+}
+
+/**
+ * @brief       获取工号过滤器统计
+ * @param stat  统计信息
+ * @return      false表示过滤器未启用，否则为成功
+ */
+bool get_id_filter_stat(bloom_stat_t *stat) {
+    if (s_id_filter == NULL || stat == NULL) {
+        return false;
+    }
+    get_bloom_filter_stat(s_id_filter, stat);
+    return true;
+}
+
+/**
+ * @brief   创建数据库[分片数量默认为CPU核数]
  * @return  false表示失败，否则为成功
  */
 bool create_database(void) {
+    long cpu_count = s_config_shard_count != 0 ? s_config_shard_count : sysconf(_SC_NPROCESSORS_ONLN);
+    s_shard_count = cpu_count < 1 ? 1 : (cpu_count > MAX_SHARD_COUNT ? MAX_SHARD_COUNT : (uint32_t)cpu_count);
+    uint64_t shard_size = default_table_size / s_shard_count;
+
     table_init_config_t config = {
-        .max_size = default_table_size,
-        .value_size = sizeof(staff_info_t),
+        .max_size = shard_size < min_shard_size ? min_shard_size : shard_size,
+        .value_size = sizeof(staff_record_t),
         .clear_func = clear_value,
         .copy_func = copy_value,
-        .match_func = is_value_equal
+        .match_func = is_value_equal,
+        .value_type = MEM_RECORD
     };
-    s_hash_table = create_hash_table(&config);
-    if (s_hash_table == NULL) {
+    for (uint32_t i = 0; i < s_shard_count; i++) {
+        s_shards[i] = create_hash_table(&config);
+        if (s_shards[i] == NULL) {
+            delete_database();
+            return false;
+        }
+    }
+    long online_count = sysconf(_SC_NPROCESSORS_ONLN);
+    uint32_t thread_count = online_count > s_shard_count ? (uint32_t)online_count : s_shard_count;
+    if (s_shard_pool == NULL && thread_count > 1) {
+        s_shard_pool = create_thread_pool(thread_count, thread_count * tasks_per_thread);
+    }
+
+    table_init_config_t group_config = {
+        .max_size = default_group_size,
+        .value_size = sizeof(group_count_t),
+        .clear_func = clear_group_value,
+        .copy_func = copy_group_value,
+        .match_func = is_group_equal,
+        .value_type = MEM_INDEX
+    };
+    for (group_type_t i = GROUP_NONE + 1; i < GROUP_MAX; i++) {
+        s_group_tables[i] = create_hash_table(&group_config);
+        if (s_group_tables[i] == NULL) {
+            delete_database();
+            return false;
+        }
+    }
+    if (!create_name_index()) {
+        delete_database();
         return false;
     }
+    if (s_is_filter_enabled) {
+        s_id_filter = create_bloom_filter(default_table_size);
+        if (s_id_filter == NULL) {
+            delete_database();
+            return false;
+        }
+    }
+    s_data_version++;
     return true;
 }
 
@@ -123,7 +547,22 @@ bool create_database(void) {
  * @brief 删除数据库
  */
 void delete_database(void) {
-    delete_hash_table(&s_hash_table);
+    for (uint32_t i = 0; i < MAX_SHARD_COUNT; i++) {
+        if (s_shards[i] != NULL) {
+            delete_hash_table(&s_shards[i]);
+        }
+    }
+    for (group_type_t i = GROUP_NONE + 1; i < GROUP_MAX; i++) {
+        if (s_group_tables[i] != NULL) {
+            delete_hash_table(&s_group_tables[i]);
+        }
+    }
+    delete_name_index();
+    delete_bloom_filter(&s_id_filter);
+    if (s_change_func != NULL) {
+        s_change_func(0);
+    }
+    s_data_version++;
 }
 
 /**
@@ -132,7 +571,29 @@ void delete_database(void) {
  * @return      false表示失败，否则为成功
  */
 bool add_item_to_database(staff_info_t *info) {
-    return add_item_to_table(&s_hash_table, info->staff_id, info, true);
+    staff_record_t *record = create_record(info);
+    if (record == NULL) {
+        return false;
+    }
+    // 过滤器判定不存在时跳过重复检查
+    bool is_maybe_exist = is_id_maybe_exist(info->staff_id);
+    bool is_added = is_maybe_exist ? add_item_to_table(get_shard_table(info->staff_id), info->staff_id, record, false) :
+        add_unique_item_to_table(get_shard_table(info->staff_id), info->staff_id, record, false);
+    if (!is_added) {
+        clear_value(record);
+        return false;
+    }
+    if (is_maybe_exist && s_id_filter != NULL) {
+        mark_bloom_false_positive(s_id_filter);
+    }
+    add_key_to_bloom_filter(s_id_filter, info->staff_id);
+    if (is_bloom_filter_full(s_id_filter)) {
+        rebuild_id_filter();
+    }
+    update_group_counters(info, true);
+    add_name_to_index(info->name, info->staff_id);
+    s_data_version++;
+    return true;
 }
 
 /**
@@ -141,16 +602,152 @@ bool add_item_to_database(staff_info_t *info) {
  * @return          false表示失败，否则为成功
  */
 bool remove_item_from_database(uint64_t staff_id) {
-    return remove_item_from_table(s_hash_table, staff_id);
+    hash_table_t *table = *get_shard_table(staff_id);
+    staff_info_t *item = get_by_id_from_database(staff_id);
+    if (item == NULL) {
+        return false;
+    }
+    update_group_counters(item, false);
+    remove_name_from_index(item->name, staff_id);
+    if (!remove_item_from_table(table, staff_id)) {
+        return false;
+    }
+    remove_key_from_bloom_filter(s_id_filter, staff_id);
+    if (s_change_func != NULL) {
+        s_change_func(staff_id);
+    }
+    s_data_version++;
+    return true;
 }
 
 /**
- * @brief       修改员工信息
- * @param info  员工信息
- * @return      false表示失败，否则为成功
+ * @brief           判定并清理待批量删除员工[哈希表删除判定回调，删除前维护分组计数、姓名索引及过滤器]
+ * @param value     员工信息
+ * @param context   批量删除上下文
+ * @return          true表示删除该员工
+ */
+static bool remove_matched_staff(void *value, void *context) {
+    staff_info_t *item = (staff_info_t *)value;
+    remove_context_t *remove = (remove_context_t *)context;
+    if ((remove->date_from != 0 && item->date < remove->date_from) ||
+        (remove->date_to != 0 && item->date > remove->date_to)) {
+        return false;
+    }
+    remove->count++;
+    if (remove->is_dry_run) {
+        return false;
+    }
+
+    if (remove->func != NULL) {
+        remove->func(item, remove->context);
+    }
+    update_group_counters(item, false);
+    remove_name_from_index(item->name, item->staff_id);
+    remove_key_from_bloom_filter(s_id_filter, item->staff_id);
+    if (s_change_func != NULL) {
+        s_change_func(item->staff_id);
+    }
+    return true;
+}
+
+/**
+ * @brief               按条件批量删除员工[各分片单次遍历原地摘除，无需先查询再逐个删除]
+ * @param info          员工信息[NULL表示通配，其余同过滤查询]
+ * @param date_from     入职日期下限[含，0表示不限]
+ * @param date_to       入职日期上限[含，0表示不限]
+ * @param is_dry_run    仅统计匹配数量，不删除
+ * @param func          删除前回调[可为NULL]
+ * @param context       回调上下文
+ * @return              删除或匹配的员工数量
+ */
+uint64_t remove_items_by_filter_from_database(staff_info_t *info, uint64_t date_from, uint64_t date_to, bool is_dry_run,
+    traverse_staff_callback func, void *context) {
+    remove_context_t remove = {
+        .date_from = date_from,
+        .date_to = date_to,
+        .is_dry_run = is_dry_run,
+        .func = func,
+        .context = context
+    };
+    for (uint32_t i = 0; i < s_shard_count; i++) {
+        remove_items_from_table(s_shards[i], info, remove_matched_staff, &remove);
+    }
+    if (!is_dry_run && remove.count > 0) {
+        s_data_version++;
+    }
+    return remove.count;
+}
+
+/**
+ * @brief           修改员工信息
+ * @param info      员工信息[字符串为空表示不修改，日期为0表示不修改]
+ * @param is_move   是否转移字符串所有权[需存放于堆上的新值直接转移至记录，info中对应字段置空]
+ * @param changed   实际变更字段[modify_field_t位与，可为NULL]
+ * @return          false表示失败[含待变更字段均未能更新]，否则为成功
  */
-bool modify_item_from_database(staff_info_t *info) {
-    return modify_item_from_table(s_hash_table, info->staff_id, info);
+bool modify_item_from_database(staff_info_t *info, bool is_move, uint8_t *changed) {
+    staff_record_t *record = (staff_record_t *)get_by_id_from_database(info->staff_id);
+    if (record == NULL) {
+        return false;
+    }
+
+    // 仅处理实际变更的字段[未指定或与原值相同的字段跳过]
+    staff_info_t *item = &record->info;
+    uint8_t fields = MODIFY_NONE;
+    fields |= info->date != 0 && info->date != item->date ? MODIFY_DATE : MODIFY_NONE;
+    fields |= info->name != NULL && !is_string_equal(info->name, item->name) ? MODIFY_NAME : MODIFY_NONE;
+    fields |= info->department != NULL && !is_string_equal(info->department, item->department) ? MODIFY_DEPT : MODIFY_NONE;
+    fields |= info->position != NULL && !is_string_equal(info->position, item->position) ? MODIFY_POS : MODIFY_NONE;
+    if (fields == MODIFY_NONE) {
+        if (changed != NULL) {
+            *changed = fields;
+        }
+        return true;
+    }
+
+    // 按修改前后信息分别调整分组计数及姓名索引，字符串更新失败的字段不计入实际变更
+    bool is_regrouped = (fields & (MODIFY_DATE | MODIFY_DEPT | MODIFY_POS)) != 0;
+    if (is_regrouped) {
+        update_group_counters(item, false);
+    }
+    if (fields & MODIFY_NAME) {
+        remove_name_from_index(item->name, item->staff_id);
+        if (!update_record_string(record, &item->name, &info->name, is_move)) {
+            fields &= ~MODIFY_NAME;
+        }
+        add_name_to_index(item->name, item->staff_id);
+    }
+    if (fields & MODIFY_DATE) {
+        item->date = info->date;
+    }
+    if ((fields & MODIFY_DEPT) && !update_record_string(record, &item->department, &info->department, is_move)) {
+        fields &= ~MODIFY_DEPT;
+    }
+    if ((fields & MODIFY_POS) && !update_record_string(record, &item->position, &info->position, is_move)) {
+        fields &= ~MODIFY_POS;
+    }
+    if (is_regrouped) {
+        update_group_counters(item, true);
+    }
+    if (changed != NULL) {
+        *changed = fields;
+    }
+    if (fields == MODIFY_NONE) {
+        return false;
+    }
+    if (s_change_func != NULL) {
+        s_change_func(info->staff_id);
+    }
+    s_data_version++;
+    return true;
+}
+
+/**
+ * @brief   获取数据版本[任一增删改操作成功后递增]
+ * @return  数据版本
+ */
+uint64_t get_database_version(void) {
+    return s_data_version;
 }
 
 /**
@@ -159,18 +756,289 @@ bool modify_item_from_database(staff_info_t *info) {
  * @return          NULL表示失败，否则为成功
  */
 staff_info_t *get_by_id_from_database(uint64_t staff_id) {
-    staff_info_t *item = (staff_info_t *)get_item_by_key(s_hash_table, staff_id);
+    // 过滤器判定不存在时无需遍历桶链表
+    if (!is_id_maybe_exist(staff_id)) {
+        return NULL;
+    }
+    staff_info_t *item = (staff_info_t *)get_item_by_key(*get_shard_table(staff_id), staff_id);
+    if (item == NULL && s_id_filter != NULL) {
+        mark_bloom_false_positive(s_id_filter);
+    }
     return item;
 }
 
 /**
- * @brief       获取信息匹配的所有员工信息
+ * @brief           批量获取指定工号员工信息[流水线预取：先预取较远工号的过滤块及桶，桶到达后预取较近工号的首结点]
+ * @param ids       工号数组
+ * @param count     工号数量
+ * @param items     员工信息数组[与工号一一对应，不存在时为NULL]
+ * @return          存在的员工数量
+ */
+uint64_t get_by_ids_from_database(const uint64_t *ids, uint64_t count, staff_info_t **items) {
+    if (ids == NULL || items == NULL) {
+        return 0;
+    }
+
+    uint64_t found = 0;
+    for (uint64_t i = 0; i < count; i++) {
+        if (i + prefetch_distance * 2 < count) {
+            uint64_t key = ids[i + prefetch_distance * 2];
+            prefetch_bloom_filter_key(s_id_filter, key);
+            prefetch_bucket_by_key(*get_shard_table(key), key);
+        }
+        if (i + prefetch_distance < count) {
+            uint64_t key = ids[i + prefetch_distance];
+            prefetch_node_by_key(*get_shard_table(key), key);
+        }
+        items[i] = ids[i] != 0 ? get_by_id_from_database(ids[i]) : NULL;
+        found += items[i] != NULL ? 1 : 0;
+    }
+    return found;
+}
+
+/**
+ * @brief       扫描单个分片[分片线程池任务]
+ * @param arg   分片扫描任务
+ */
+static void scan_shard(void *arg) {
+    shard_scan_t *scan = (shard_scan_t *)arg;
+    scan->items = (staff_info_t **)get_items_by_value_in_range(scan->table, scan->info, scan->begin, scan->end, &scan->count);
+}
+
+/**
+ * @brief           切分扫描任务[各分片按桶区间切分，使任务数约为线程数的若干倍]
+ * @param info      员工信息[NULL表示通配]
+ * @param count     扫描任务数量
+ * @return          NULL表示失败，否则为扫描任务数组[需调用方按MEM_RESULT分类释放]
+ */
+static shard_scan_t *split_shard_scans(staff_info_t *info, uint32_t *count) {
+    uint32_t thread_count = get_thread_count(s_shard_pool);
+    uint32_t target = thread_count > 1 ? thread_count * tasks_per_thread : 1;
+    uint32_t per_shard = (target + s_shard_count - 1) / s_shard_count;
+    uint32_t ranges[MAX_SHARD_COUNT] = {0};
+    uint32_t total = 0;
+
+    for (uint32_t i = 0; i < s_shard_count; i++) {
+        uint64_t buckets = get_bucket_count_from_table(s_shards[i]);
+        uint64_t limit = buckets / min_range_buckets;
+        ranges[i] = per_shard < limit ? per_shard : (limit > 0 ? (uint32_t)limit : 1);
+        total += ranges[i];
+    }
+    shard_scan_t *scans = mem_calloc(MEM_RESULT, total, sizeof(shard_scan_t));
+    if (scans == NULL) {
+        return NULL;
+    }
+
+    uint32_t index = 0;
+    for (uint32_t i = 0; i < s_shard_count; i++) {
+        uint64_t buckets = get_bucket_count_from_table(s_shards[i]);
+        for (uint32_t j = 0; j < ranges[i]; j++, index++) {
+            scans[index].table = s_shards[i];
+            scans[index].begin = buckets * j / ranges[i];
+            scans[index].end = buckets * (j + 1) / ranges[i];
+            scans[index].info = info;
+        }
+    }
+    *count = total;
+    return scans;
+}
+
+/**
+ * @brief       并行扫描所有分片获取信息匹配的所有员工信息[无序，需排序时由调用方排序]
  * @param info  员工信息[NULL表示通配]
  * @param count 匹配的员工数量
- * @return      NULL表示失败，否则为成功[动态申请内存，需调用方释放]
+ * @return      NULL表示失败，否则为成功[动态申请内存，需调用方按MEM_RESULT分类释放]
  */
 staff_info_t **get_by_info_from_database(staff_info_t *info, uint64_t *count) {
+    if (count == NULL) {
+        return NULL;
+    }
+
+    *count = 0;
+    uint32_t scan_count = 0;
+    shard_scan_t *scans = split_shard_scans(info, &scan_count);
+    if (scans == NULL) {
+        return NULL;
+    }
+    run_thread_tasks(s_shard_pool, scan_shard, scans, sizeof(shard_scan_t), scan_count);
+
+    uint64_t total = 0;
+    for (uint32_t i = 0; i < scan_count; i++) {
+        total += scans[i].count;
+    }
+    staff_info_t **items = mem_calloc(MEM_RESULT, total > 0 ? total : 1, sizeof(staff_info_t *));
+    if (items != NULL) {
+        uint64_t offset = 0;
+        for (uint32_t i = 0; i < scan_count; i++) {
+            if (scans[i].count > 0) {
+                memcpy(items + offset, scans[i].items, scans[i].count * sizeof(staff_info_t *));
+            }
+            offset += scans[i].count;
+        }
+        *count = total;
+    }
+    for (uint32_t i = 0; i < scan_count; i++) {
+        MEM_FREE(MEM_RESULT, scans[i].items)
+    }
+    MEM_FREE(MEM_RESULT, scans)
+    return items;
+}
+
+/**
+ * @brief           按姓名前缀、子串或模糊匹配获取员工信息[由姓名索引给出候选，无需遍历全部员工；无序]
+ * @param info      员工信息[name为查询串，其余信息精确匹配]
+ * @param match     姓名匹配方式
+ * @param distance  最大编辑距离[仅模糊匹配使用]
+ * @param count     匹配的员工数量
+ * @return          NULL表示失败，否则为成功[动态申请内存，需调用方按MEM_RESULT分类释放]
+ */
+staff_info_t **get_by_name_pattern_from_database(staff_info_t *info, name_match_t match, uint8_t distance, uint64_t *count) {
+    if (info == NULL || count == NULL) {
+        return NULL;
+    }
+    if (match == NAME_EXACT || info->name == NULL) {
+        return get_by_info_from_database(info, count);
+    }
+
+    *count = 0;
+    staff_info_t filter = *info;
+    filter.name = NULL;
+    uint64_t *ids = NULL;
+    uint64_t id_count = 0;
     staff_info_t **items = NULL;
-    items = (staff_info_t **)get_items_by_value(s_hash_table, info, count);
+
+    // 查询串过短无法使用索引时退化为遍历后按姓名过滤
+    if (!get_ids_from_name_index(info->name, match, distance, &ids, &id_count)) {
+        uint64_t total = 0;
+        items = get_by_info_from_database(&filter, &total);
+        for (uint64_t i = 0; items != NULL && i < total; i++) {
+            if (is_name_matched(items[i]->name, info->name, match, distance)) {
+                items[(*count)++] = items[i];
+            }
+        }
+        return items;
+    }
+
+    items = mem_calloc(MEM_RESULT, id_count > 0 ? id_count : 1, sizeof(staff_info_t *));
+    for (uint64_t i = 0; items != NULL && i < id_count; i++) {
+        staff_info_t *item = get_by_id_from_database(ids[i]);
+        if (item != NULL && is_name_matched(item->name, info->name, match, distance) && is_value_equal(&filter, item)) {
+            items[(*count)++] = item;
+        }
+    }
+    MEM_FREE(MEM_RESULT, ids)
     return items;
 }
+
+/**
+ * @brief           遍历项转发至调用方回调
+ * @param value     员工信息
+ * @param context   遍历上下文
+ * @return          false表示终止遍历，否则为继续
+ */
+static bool forward_traverse_item(void *value, void *context) {
+    traverse_context_t *traverse = (traverse_context_t *)context;
+    const staff_info_t *info = (const staff_info_t *)value;
+    if (traverse->pattern != NULL && !is_name_matched(info->name, traverse->pattern, traverse->match, traverse->distance)) {
+        return true;
+    }
+    return traverse->func(info, traverse->context);
+}
+
+/**
+ * @brief           遍历信息匹配的所有员工[不申请结果数组]
+ * @param info      员工信息[NULL表示通配]
+ * @param func      匹配项回调
+ * @param context   回调上下文
+ * @return          false表示失败或遍历被终止，否则为成功
+ */
+bool traverse_database(staff_info_t *info, traverse_staff_callback func, void *context) {
+    if (func == NULL) {
+        return false;
+    }
+
+    traverse_context_t traverse = {
+        .func = func,
+        .context = context
+    };
+    for (uint32_t i = 0; i < s_shard_count; i++) {
+        if (!traverse_items_from_table(s_shards[i], info, forward_traverse_item, &traverse)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief           按姓名前缀、子串或模糊匹配遍历员工[由姓名索引给出候选，过短无法使用索引时遍历后按姓名过滤；不申请结果数组]
+ * @param info      员工信息[name为查询串，其余信息精确匹配]
+ * @param match     姓名匹配方式
+ * @param distance  最大编辑距离[仅模糊匹配使用]
+ * @param func      匹配项回调
+ * @param context   回调上下文
+ * @return          false表示失败或遍历被终止，否则为成功
+ */
+bool traverse_by_name_pattern_from_database(staff_info_t *info, name_match_t match, uint8_t distance,
+    traverse_staff_callback func, void *context) {
+    if (info == NULL || func == NULL) {
+        return false;
+    }
+    if (match == NAME_EXACT || info->name == NULL) {
+        return traverse_database(info, func, context);
+    }
+
+    staff_info_t filter = *info;
+    filter.name = NULL;
+    uint64_t *ids = NULL;
+    uint64_t id_count = 0;
+    if (!get_ids_from_name_index(info->name, match, distance, &ids, &id_count)) {
+        traverse_context_t traverse = {
+            .func = func,
+            .context = context,
+            .pattern = info->name,
+            .match = match,
+            .distance = distance
+        };
+        for (uint32_t i = 0; i < s_shard_count; i++) {
+            if (!traverse_items_from_table(s_shards[i], &filter, forward_traverse_item, &traverse)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool is_finished = true;
+    for (uint64_t i = 0; i < id_count && is_finished; i++) {
+        staff_info_t *item = get_by_id_from_database(ids[i]);
+        if (item != NULL && is_name_matched(item->name, info->name, match, distance) && is_value_equal(&filter, item)) {
+            is_finished = func(item, context);
+        }
+    }
+    MEM_FREE(MEM_RESULT, ids)
+    return is_finished;
+}
+
+/**
+ * @brief   获取员工总数
+ * @return  员工总数
+ */
+uint64_t get_count_from_database(void) {
+    uint64_t count = 0;
+    for (uint32_t i = 0; i < s_shard_count; i++) {
+        count += get_count_from_table(s_shards[i]);
+    }
+    return count;
+}
+
+/**
+ * @brief       获取指定方式的所有分组计数[计数由增删改操作增量维护，无需遍历员工]
+ * @param type  分组方式
+ * @param count 分组数量[含计数为0的分组]
+ * @return      NULL表示失败，否则为成功[动态申请内存，需调用方按MEM_RESULT分类释放]
+ */
+group_count_t **get_group_counts_from_database(group_type_t type, uint64_t *count) {
+    if (type <= GROUP_NONE || type >= GROUP_MAX || count == NULL) {
+        return NULL;
+    }
+    return (group_count_t **)get_items_by_value(s_group_tables[type], NULL, count);
+}
@@ -12,13 +12,52 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "common.h"
+#include "bloom_filter.h"
+#include "thread_pool.h"
 
+/**
+ * @brief 分组计数
+ */
+typedef struct {
+    char *value;        // 分组值[部门、职位或年份]
+    uint64_t count;     // 员工数量
+} group_count_t;
+
+/**
+ * @brief 修改字段
+ */
+typedef enum {
+    MODIFY_NONE = 0,        // 无变更
+    MODIFY_DATE = 1 << 0,   // 入职日期
+    MODIFY_NAME = 1 << 1,   // 姓名
+    MODIFY_DEPT = 1 << 2,   // 部门
+    MODIFY_POS  = 1 << 3    // 职位
+} modify_field_t;
+
+typedef bool(*traverse_staff_callback)(const staff_info_t *info, void *context);  // 员工遍历回调[返回false终止遍历]
+typedef void(*change_staff_callback)(uint64_t staff_id);                            // 员工变更回调[修改或删除后调用，0表示全部删除]
+
+void set_database_shard_count(uint32_t count);
+void set_database_id_filter(bool is_enabled);
+void set_database_change_callback(change_staff_callback func);
+bool get_id_filter_stat(bloom_stat_t *stat);
+thread_pool_t *get_database_thread_pool(void);
 bool create_database(void);
 void delete_database(void);
 bool add_item_to_database(staff_info_t *info);
 bool remove_item_from_database(uint64_t staff_id);
-bool modify_item_from_database(staff_info_t *info);
+uint64_t remove_items_by_filter_from_database(staff_info_t *info, uint64_t date_from, uint64_t date_to, bool is_dry_run,
+    traverse_staff_callback func, void *context);
+bool modify_item_from_database(staff_info_t *info, bool is_move, uint8_t *changed);
+uint64_t get_database_version(void);
 staff_info_t *get_by_id_from_database(uint64_t staff_id);
+uint64_t get_by_ids_from_database(const uint64_t *ids, uint64_t count, staff_info_t **items);
 staff_info_t **get_by_info_from_database(staff_info_t *info, uint64_t *count);
+staff_info_t **get_by_name_pattern_from_database(staff_info_t *info, name_match_t match, uint8_t distance, uint64_t *count);
+bool traverse_database(staff_info_t *info, traverse_staff_callback func, void *context);
+bool traverse_by_name_pattern_from_database(staff_info_t *info, name_match_t match, uint8_t distance,
+    traverse_staff_callback func, void *context);
+uint64_t get_count_from_database(void);
+group_count_t **get_group_counts_from_database(group_type_t type, uint64_t *count);
 
 #endif /* database_manager_h */
\ No newline at end of file
@@ -8,18 +8,64 @@
 #include "command_execution.h"
 #include "database_manager.h"
 #include "manager_server.h"
+#include "replication.h"
+#include "query_cache.h"
+#include <string.h>
+#include <signal.h>
+
+static const char shard_flag[] = "--shards:";       // 分片数量启动参数
+static const char port_flag[] = "--port:";          // 服务端端口启动参数
+static const char primary_flag[] = "--primary:";    // 主节点复制端口启动参数
+static const char follow_flag[] = "--follow:";      // 跟随主节点复制端口启动参数
+static const char bloom_flag[] = "--bloom:";        // 工号过滤器开关启动参数[on/off]
+static const char workers_flag[] = "--workers:";    // 请求执行线程数量启动参数[0表示在输入线程直接执行]
+static const uint32_t default_workers = 4;          // 默认请求执行线程数量
 
 int main(int argc, const char * argv[]) {
+    repl_role_t repl_role = REPL_NONE;
+    uint16_t repl_port = 0;
+    uint32_t workers = default_workers;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], shard_flag, strlen(shard_flag)) == 0) {
+            set_database_shard_count((uint32_t)atoi(argv[i] + strlen(shard_flag)));
+        }
+        else if (strncmp(argv[i], bloom_flag, strlen(bloom_flag)) == 0) {
+            set_database_id_filter(strcmp(argv[i] + strlen(bloom_flag), "off") != 0);
+        }
+        else if (strncmp(argv[i], workers_flag, strlen(workers_flag)) == 0) {
+            workers = (uint32_t)atoi(argv[i] + strlen(workers_flag));
+        }
+        else if (strncmp(argv[i], port_flag, strlen(port_flag)) == 0) {
+            set_server_port((uint16_t)atoi(argv[i] + strlen(port_flag)));
+        }
+        else if (strncmp(argv[i], primary_flag, strlen(primary_flag)) == 0) {
+            repl_role = REPL_PRIMARY;
+            repl_port = (uint16_t)atoi(argv[i] + strlen(primary_flag));
+        }
+        else if (strncmp(argv[i], follow_flag, strlen(follow_flag)) == 0) {
+            repl_role = REPL_FOLLOWER;
+            repl_port = (uint16_t)atoi(argv[i] + strlen(follow_flag));
+        }
+    }
+    // 客户端断开时写入不应终止服务端
+    signal(SIGPIPE, SIG_IGN);
     if (!create_database()) {
         return -1;
     }
+    if (repl_role != REPL_NONE && !init_replication(repl_role, repl_port)) {
+        return -1;
+    }
+    set_server_workers(workers);
     if (!init_socket_server()) {
         return -1;
     }
 
-    while (true) {
-        process_all_requests();
-    }
-    
+    while (process_all_requests());
+
+    // 请求队列已排空，持有独占执行权直至退出，本地输入线程不再执行指令
+    uninit_socket_server();
+    acquire_command_gate(GATE_EXCLUSIVE);
+    clear_query_cache();
+    delete_database();
     return 0;
 }
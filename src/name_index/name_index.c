@@ -0,0 +1,706 @@
+//
+//  name_index.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "name_index.h"
+#include "hash_table.h"
+#include "log.h"
+#include "mem_stat.h"
+#include <string.h>
+
+static const uint64_t default_gram_size = 4096;     // 默认三元组表容量
+static const uint64_t min_posting_size = 8;         // 倒排集合最小容量
+static const uint64_t removed_id = UINT64_MAX;      // 倒排集合删除标记
+static const uint8_t gram_size = 3;                 // 三元组长度
+static const uint8_t anchor_size = 2;               // 姓名起始锚定字符数量
+static const char anchor_char = '^';                // 姓名起始锚定字符[非字母，不与姓名冲突]
+static const uint8_t myers_word_bits = 64;          // 位并行编辑距离单字最大模式长度
+static const uint8_t min_child_size = 4;            // BK树结点子结点数组最小容量
+static hash_table_t *s_gram_table = NULL;           // 三元组倒排表[主键为三元组字节拼接]
+
+/**
+ * @brief 三元组倒排集合[开放寻址，0表示空位]
+ */
+typedef struct {
+    uint64_t *ids;      // 工号集合
+    uint64_t capacity;  // 集合容量[2的幂]
+    uint64_t count;     // 有效工号数量
+    uint64_t used;      // 已占用位置数量[含删除标记]
+} gram_posting_t;
+
+typedef struct bk_child bk_child_t;
+
+/**
+ * @brief BK树结点[每个不同姓名一个结点]
+ */
+typedef struct bk_node {
+    char *name;             // 姓名
+    gram_posting_t ids;     // 同名工号集合[为空时保留结点，保证树结构完整]
+    bk_child_t *children;   // 子结点数组
+    uint32_t child_count;   // 子结点数量
+    uint32_t child_size;    // 子结点数组容量
+} bk_node_t;
+
+/**
+ * @brief BK树子结点[按与父结点的编辑距离区分]
+ */
+struct bk_child {
+    uint32_t distance;      // 与父结点姓名的编辑距离
+    bk_node_t *node;        // 子结点
+};
+
+/**
+ * @brief 位并行编辑距离模式[Myers算法，模式长度不超过64]
+ */
+typedef struct {
+    const char *string;     // 模式串
+    size_t length;          // 模式串长度
+    uint64_t peq[256];      // 各字符在模式串中出现位置掩码
+} myers_pattern_t;
+
+static bk_node_t *s_bk_root = NULL;                 // 姓名BK树根结点
+
+/**
+ * @brief       清理倒排集合
+ * @param value 待清理值
+ */
+STATIC void clear_posting(void *value) {
+    gram_posting_t *posting = (gram_posting_t *)value;
+    if (posting != NULL) {
+        MEM_FREE(MEM_INDEX, posting->ids)
+        MEM_FREE(MEM_INDEX, posting)
+    }
+}
+
+/**
+ * @brief       拷贝倒排集合[浅拷贝，仅在新建空集合时使用]
+ * @param dst   拷贝至
+ * @param src   拷贝于
+ */
+STATIC void copy_posting(void *dst, const void *src) {
+    if (dst != NULL && src != NULL) {
+        memcpy(dst, src, sizeof(gram_posting_t));
+    }
+}
+
+/**
+ * @brief       比较倒排集合[倒排表仅按主键访问，不支持按值匹配]
+ * @param src   集合1
+ * @param dst   集合2
+ * @return      false表示不同
+ */
+STATIC bool is_posting_equal(const void *src, const void *dst) {
+    return false;
+}
+
+/**
+ * @brief           获取三元组主键[前anchor个位置视为锚定字符]
+ * @param string    字符串
+ * @param anchor    锚定字符数量
+ * @param index     三元组起点[相对于锚定后的字符串]
+ * @return          三元组主键
+ */
+static inline uint64_t get_gram_key(const char *string, size_t anchor, size_t index) {
+    uint64_t key = 0;
+    for (size_t i = index; i < index + gram_size; i++) {
+        uint8_t ch = i < anchor ? anchor_char : (uint8_t)string[i - anchor];
+        key = (key << 8) | ch;
+    }
+    return key;
+}
+
+/**
+ * @brief           获取锚定后字符串的三元组数量
+ * @param length    字符串长度
+ * @param anchor    锚定字符数量
+ * @return          三元组数量
+ */
+static inline size_t get_gram_count(size_t length, size_t anchor) {
+    return length + anchor < gram_size ? 0 : length + anchor - gram_size + 1;
+}
+
+/**
+ * @brief       计算工号在集合中的起始位置
+ * @param id    工号
+ * @param mask  集合容量掩码
+ * @return      起始位置
+ */
+static inline uint64_t get_posting_slot(uint64_t id, uint64_t mask) {
+    return ((id * 11400714819323198549UL) >> 32) & mask;
+}
+
+/**
+ * @brief           重建倒排集合[清除删除标记]
+ * @param posting   倒排集合
+ * @param capacity  新容量[2的幂]
+ * @return          false表示失败，否则为成功
+ */
+static bool resize_posting(gram_posting_t *posting, uint64_t capacity) {
+    uint64_t *ids = mem_calloc(MEM_INDEX, capacity, sizeof(uint64_t));
+    if (ids == NULL) {
+        LOG_C(LOG_ERROR, "Failed to calloc resources for name index.")
+        return false;
+    }
+
+    uint64_t mask = capacity - 1;
+    for (uint64_t i = 0; i < posting->capacity; i++) {
+        uint64_t id = posting->ids[i];
+        if (id == 0 || id == removed_id) {
+            continue;
+        }
+        uint64_t slot = get_posting_slot(id, mask);
+        while (ids[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        ids[slot] = id;
+    }
+    MEM_FREE(MEM_INDEX, posting->ids)
+    posting->ids = ids;
+    posting->capacity = capacity;
+    posting->used = posting->count;
+    return true;
+}
+
+/**
+ * @brief           插入工号至倒排集合[已存在时忽略]
+ * @param posting   倒排集合
+ * @param id        工号
+ * @return          false表示失败，否则为成功
+ */
+static bool insert_posting_id(gram_posting_t *posting, uint64_t id) {
+    // 占用率超过3/4时按有效数量两倍重建
+    if ((posting->used + 1) * 4 > posting->capacity * 3) {
+        uint64_t capacity = min_posting_size;
+        while (capacity < (posting->count + 1) * 2) {
+            capacity <<= 1;
+        }
+        if (!resize_posting(posting, capacity)) {
+            return false;
+        }
+    }
+
+    uint64_t mask = posting->capacity - 1;
+    uint64_t slot = get_posting_slot(id, mask);
+    uint64_t *target = NULL;
+    while (posting->ids[slot] != 0) {
+        if (posting->ids[slot] == id) {
+            return true;
+        }
+        if (posting->ids[slot] == removed_id && target == NULL) {
+            target = &posting->ids[slot];
+        }
+        slot = (slot + 1) & mask;
+    }
+    if (target == NULL) {
+        target = &posting->ids[slot];
+        posting->used++;
+    }
+    *target = id;
+    posting->count++;
+    return true;
+}
+
+/**
+ * @brief           从倒排集合删除工号
+ * @param posting   倒排集合
+ * @param id        工号
+ */
+static void erase_posting_id(gram_posting_t *posting, uint64_t id) {
+    if (posting->capacity == 0) {
+        return;
+    }
+
+    uint64_t mask = posting->capacity - 1;
+    uint64_t slot = get_posting_slot(id, mask);
+    while (posting->ids[slot] != 0) {
+        if (posting->ids[slot] == id) {
+            posting->ids[slot] = removed_id;
+            posting->count--;
+            return;
+        }
+        slot = (slot + 1) & mask;
+    }
+}
+
+/**
+ * @brief           初始化位并行编辑距离模式
+ * @param pattern   待初始化模式
+ * @param string    模式串
+ */
+static void init_myers_pattern(myers_pattern_t *pattern, const char *string) {
+    bzero(pattern->peq, sizeof(pattern->peq));
+    pattern->string = string;
+    pattern->length = strlen(string);
+    if (pattern->length > myers_word_bits) {
+        return;
+    }
+    for (size_t i = 0; i < pattern->length; i++) {
+        pattern->peq[(uint8_t)string[i]] |= 1UL << i;
+    }
+}
+
+/**
+ * @brief           逐行动态规划计算编辑距离[模式串超过64字符时使用]
+ * @param src       字符串1
+ * @param src_len   字符串1长度
+ * @param dst       字符串2
+ * @return          编辑距离
+ */
+static uint32_t get_dp_distance(const char *src, size_t src_len, const char *dst) {
+    uint32_t *row = mem_calloc(MEM_RESULT, src_len + 1, sizeof(uint32_t));
+    if (row == NULL) {
+        return UINT32_MAX;
+    }
+
+    for (size_t i = 0; i <= src_len; i++) {
+        row[i] = (uint32_t)i;
+    }
+    for (size_t j = 1; dst[j-1] != '\0'; j++) {
+        uint32_t diagonal = row[0];
+        row[0] = (uint32_t)j;
+        for (size_t i = 1; i <= src_len; i++) {
+            uint32_t temp = row[i];
+            uint32_t cost = diagonal + (src[i-1] == dst[j-1] ? 0 : 1);
+            uint32_t least = row[i] < row[i-1] ? row[i] + 1 : row[i-1] + 1;
+            row[i] = cost < least ? cost : least;
+            diagonal = temp;
+        }
+    }
+    uint32_t distance = row[src_len];
+    MEM_FREE(MEM_RESULT, row)
+    return distance;
+}
+
+/**
+ * @brief           计算模式串与文本的编辑距离[Myers位并行算法，逐字符O(1)]
+ * @param pattern   位并行模式
+ * @param text      文本
+ * @return          编辑距离
+ */
+static uint32_t get_myers_distance(const myers_pattern_t *pattern, const char *text) {
+    if (pattern->length > myers_word_bits) {
+        return get_dp_distance(pattern->string, pattern->length, text);
+    }
+    if (pattern->length == 0) {
+        return (uint32_t)strlen(text);
+    }
+
+    uint64_t pv = UINT64_MAX;
+    uint64_t mv = 0;
+    uint64_t high_bit = 1UL << (pattern->length - 1);
+    uint32_t score = (uint32_t)pattern->length;
+
+    for (const char *ch = text; *ch != '\0'; ch++) {
+        uint64_t eq = pattern->peq[(uint8_t)*ch];
+        uint64_t xv = eq | mv;
+        uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+        uint64_t ph = mv | ~(xh | pv);
+        uint64_t mh = pv & xh;
+        if (ph & high_bit) {
+            score++;
+        }
+        else if (mh & high_bit) {
+            score--;
+        }
+        // 首行为全局距离边界，每列水平差值恒为+1
+        ph = (ph << 1) | 1;
+        mh <<= 1;
+        pv = mh | ~(xv | ph);
+        mv = ph & xv;
+    }
+    return score;
+}
+
+/**
+ * @brief       计算两个字符串的编辑距离[插入、删除、替换代价均为1]
+ * @param src   字符串1
+ * @param dst   字符串2
+ * @return      编辑距离
+ */
+uint32_t get_edit_distance(const char *src, const char *dst) {
+    if (src == NULL || dst == NULL) {
+        return UINT32_MAX;
+    }
+
+    myers_pattern_t pattern;
+    init_myers_pattern(&pattern, src);
+    return get_myers_distance(&pattern, dst);
+}
+
+/**
+ * @brief       压入BK树遍历栈[容量不足时翻倍扩容]
+ * @param stack 遍历栈
+ * @param size  栈容量
+ * @param top   栈顶位置
+ * @param node  待压入结点
+ * @return      false表示失败，否则为成功
+ */
+static bool push_bk_node(bk_node_t ***stack, size_t *size, size_t *top, bk_node_t *node) {
+    if (*top == *size) {
+        size_t new_size = *size == 0 ? min_child_size : *size * 2;
+        bk_node_t **new_stack = mem_realloc(MEM_RESULT, *stack, new_size * sizeof(bk_node_t *));
+        if (new_stack == NULL) {
+            LOG_C(LOG_ERROR, "Failed to realloc resources for name index.")
+            return false;
+        }
+        *stack = new_stack;
+        *size = new_size;
+    }
+    (*stack)[(*top)++] = node;
+    return true;
+}
+
+/**
+ * @brief       释放BK树[借助遍历栈，避免退化树递归过深]
+ * @param root  根结点
+ */
+static void free_bk_tree(bk_node_t *root) {
+    bk_node_t **stack = NULL;
+    size_t size = 0;
+    size_t top = 0;
+
+    if (root == NULL || !push_bk_node(&stack, &size, &top, root)) {
+        return;
+    }
+    while (top > 0) {
+        bk_node_t *node = stack[--top];
+        for (uint32_t i = 0; i < node->child_count; i++) {
+            push_bk_node(&stack, &size, &top, node->children[i].node);
+        }
+        MEM_FREE(MEM_INDEX, node->name)
+        MEM_FREE(MEM_INDEX, node->ids.ids)
+        MEM_FREE(MEM_INDEX, node->children)
+        MEM_FREE(MEM_INDEX, node)
+    }
+    MEM_FREE(MEM_RESULT, stack)
+}
+
+/**
+ * @brief       新建BK树结点
+ * @param name  姓名
+ * @return      NULL表示失败，否则为成功
+ */
+static bk_node_t *create_bk_node(const char *name) {
+    bk_node_t *node = mem_calloc(MEM_INDEX, 1, sizeof(bk_node_t));
+    if (node == NULL) {
+        return NULL;
+    }
+    node->name = mem_strndup(MEM_INDEX, name, strlen(name));
+    if (node->name == NULL) {
+        MEM_FREE(MEM_INDEX, node)
+        return NULL;
+    }
+    return node;
+}
+
+/**
+ * @brief           查找姓名所在BK树结点
+ * @param name      姓名
+ * @param is_create 不存在时是否新建
+ * @return          NULL表示不存在或新建失败，否则为成功
+ */
+static bk_node_t *find_bk_node(const char *name, bool is_create) {
+    if (s_bk_root == NULL) {
+        s_bk_root = is_create ? create_bk_node(name) : NULL;
+        return s_bk_root;
+    }
+
+    myers_pattern_t pattern;
+    init_myers_pattern(&pattern, name);
+    bk_node_t *node = s_bk_root;
+    while (true) {
+        uint32_t distance = get_myers_distance(&pattern, node->name);
+        if (distance == 0) {
+            return node;
+        }
+
+        bk_child_t *child = NULL;
+        for (uint32_t i = 0; i < node->child_count; i++) {
+            if (node->children[i].distance == distance) {
+                child = &node->children[i];
+                break;
+            }
+        }
+        if (child != NULL) {
+            node = child->node;
+            continue;
+        }
+        if (!is_create) {
+            return NULL;
+        }
+
+        // 按编辑距离挂接为新子结点
+        if (node->child_count == node->child_size) {
+            uint32_t new_size = node->child_size == 0 ? min_child_size : node->child_size * 2;
+            bk_child_t *children = mem_realloc(MEM_INDEX, node->children, new_size * sizeof(bk_child_t));
+            if (children == NULL) {
+                return NULL;
+            }
+            node->children = children;
+            node->child_size = new_size;
+        }
+        bk_node_t *new_node = create_bk_node(name);
+        if (new_node == NULL) {
+            return NULL;
+        }
+        node->children[node->child_count].distance = distance;
+        node->children[node->child_count].node = new_node;
+        node->child_count++;
+        return new_node;
+    }
+}
+
+/**
+ * @brief           在BK树中查找编辑距离不超过阈值的所有工号[按三角不等式剪枝]
+ * @param pattern   查询串
+ * @param distance  最大编辑距离
+ * @param ids       匹配工号[动态申请内存，需调用方按MEM_RESULT分类释放]
+ * @param count     匹配数量
+ * @return          false表示失败，否则为成功
+ */
+static bool search_bk_tree(const char *pattern, uint8_t distance, uint64_t **ids, uint64_t *count) {
+    bk_node_t **stack = NULL;
+    size_t stack_size = 0;
+    size_t top = 0;
+    uint64_t size = min_posting_size;
+    uint64_t visits = 0;
+
+    *count = 0;
+    *ids = mem_calloc(MEM_RESULT, size, sizeof(uint64_t));
+    if (*ids == NULL) {
+        return false;
+    }
+    if (s_bk_root == NULL) {
+        return true;
+    }
+
+    myers_pattern_t *myers = mem_malloc(MEM_RESULT, sizeof(myers_pattern_t));
+    if (myers == NULL || !push_bk_node(&stack, &stack_size, &top, s_bk_root)) {
+        MEM_FREE(MEM_RESULT, myers)
+        MEM_FREE(MEM_RESULT, *ids)
+        return false;
+    }
+    init_myers_pattern(myers, pattern);
+
+    bool is_success = true;
+    while (top > 0 && is_success) {
+        bk_node_t *node = stack[--top];
+        uint32_t current = get_myers_distance(myers, node->name);
+        visits++;
+
+        if (current <= distance && node->ids.count > 0) {
+            if (*count + node->ids.count > size) {
+                while (size < *count + node->ids.count) {
+                    size *= 2;
+                }
+                uint64_t *new_ids = mem_realloc(MEM_RESULT, *ids, size * sizeof(uint64_t));
+                if (new_ids == NULL) {
+                    is_success = false;
+                    break;
+                }
+                *ids = new_ids;
+            }
+            for (uint64_t i = 0; i < node->ids.capacity; i++) {
+                if (node->ids.ids[i] != 0 && node->ids.ids[i] != removed_id) {
+                    (*ids)[(*count)++] = node->ids.ids[i];
+                }
+            }
+        }
+        // 仅与当前结点距离在[current-distance, current+distance]内的子树可能命中
+        for (uint32_t i = 0; i < node->child_count; i++) {
+            uint32_t child = node->children[i].distance;
+            if (child + distance >= current && child <= current + distance) {
+                is_success = push_bk_node(&stack, &stack_size, &top, node->children[i].node);
+            }
+        }
+    }
+    LOG_C(LOG_DEBUG, "Name tree visits [%llu] nodes and gives [%llu] ids for [%s].", visits, *count, pattern)
+
+    MEM_FREE(MEM_RESULT, stack)
+    MEM_FREE(MEM_RESULT, myers)
+    if (!is_success) {
+        MEM_FREE(MEM_RESULT, *ids)
+        *count = 0;
+    }
+    return is_success;
+}
+
+/**
+ * @brief   创建姓名索引
+ * @return  false表示失败，否则为成功
+ */
+bool create_name_index(void) {
+    table_init_config_t config = {
+        .max_size = default_gram_size,
+        .value_size = sizeof(gram_posting_t),
+        .clear_func = clear_posting,
+        .copy_func = copy_posting,
+        .match_func = is_posting_equal,
+        .value_type = MEM_INDEX
+    };
+    s_gram_table = create_hash_table(&config);
+    return s_gram_table != NULL;
+}
+
+/**
+ * @brief 删除姓名索引
+ */
+void delete_name_index(void) {
+    if (s_gram_table != NULL) {
+        delete_hash_table(&s_gram_table);
+    }
+    free_bk_tree(s_bk_root);
+    s_bk_root = NULL;
+}
+
+/**
+ * @brief           添加员工姓名至索引[三元组倒排及BK树，姓名起始处补两个锚定字符，使前缀查询可由三元组命中]
+ * @param name      姓名
+ * @param staff_id  工号
+ * @return          false表示失败，否则为成功
+ */
+bool add_name_to_index(const char *name, uint64_t staff_id) {
+    if (s_gram_table == NULL || name == NULL || staff_id == 0) {
+        return false;
+    }
+
+    bk_node_t *node = find_bk_node(name, true);
+    if (node == NULL || !insert_posting_id(&node->ids, staff_id)) {
+        return false;
+    }
+
+    size_t count = get_gram_count(strlen(name), anchor_size);
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = get_gram_key(name, anchor_size, i);
+        gram_posting_t *posting = (gram_posting_t *)get_item_by_key(s_gram_table, key);
+        if (posting == NULL) {
+            gram_posting_t new_posting = {0};
+            if (!add_item_to_table(&s_gram_table, key, &new_posting, true)) {
+                return false;
+            }
+            posting = (gram_posting_t *)get_item_by_key(s_gram_table, key);
+        }
+        if (posting == NULL || !insert_posting_id(posting, staff_id)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief           从索引删除员工姓名[集合为空时一并删除三元组，BK树结点保留]
+ * @param name      姓名
+ * @param staff_id  工号
+ */
+void remove_name_from_index(const char *name, uint64_t staff_id) {
+    if (s_gram_table == NULL || name == NULL || staff_id == 0) {
+        return;
+    }
+
+    bk_node_t *node = find_bk_node(name, false);
+    if (node != NULL) {
+        erase_posting_id(&node->ids, staff_id);
+    }
+
+    size_t count = get_gram_count(strlen(name), anchor_size);
+    for (size_t i = 0; i < count; i++) {
+        uint64_t key = get_gram_key(name, anchor_size, i);
+        gram_posting_t *posting = (gram_posting_t *)get_item_by_key(s_gram_table, key);
+        if (posting == NULL) {
+            continue;
+        }
+        erase_posting_id(posting, staff_id);
+        if (posting->count == 0) {
+            remove_item_from_table(s_gram_table, key);
+        }
+    }
+}
+
+/**
+ * @brief           获取候选工号[前缀或子串取查询串各三元组中最短的倒排集合，模糊匹配查找BK树，调用方需校验姓名]
+ * @param pattern   查询串
+ * @param match     匹配方式[仅支持前缀、子串或模糊匹配]
+ * @param distance  最大编辑距离[仅模糊匹配使用]
+ * @param ids       候选工号[动态申请内存，需调用方按MEM_RESULT分类释放]
+ * @param count     候选数量
+ * @return          false表示索引无法加速该查询[如子串短于三元组]，否则为成功
+ */
+bool get_ids_from_name_index(const char *pattern, name_match_t match, uint8_t distance, uint64_t **ids, uint64_t *count) {
+    if (s_gram_table == NULL || pattern == NULL || ids == NULL || count == NULL) {
+        return false;
+    }
+    if (match == NAME_FUZZY) {
+        return search_bk_tree(pattern, distance, ids, count);
+    }
+    if (match != NAME_PREFIX && match != NAME_SUBSTR) {
+        return false;
+    }
+
+    size_t anchor = match == NAME_PREFIX ? anchor_size : 0;
+    size_t gram_count = get_gram_count(strlen(pattern), anchor);
+    if (gram_count == 0) {
+        return false;
+    }
+
+    gram_posting_t *shortest = NULL;
+    for (size_t i = 0; i < gram_count; i++) {
+        gram_posting_t *posting = (gram_posting_t *)get_item_by_key(s_gram_table, get_gram_key(pattern, anchor, i));
+        // 任一三元组不存在则必无匹配
+        if (posting == NULL) {
+            shortest = NULL;
+            break;
+        }
+        if (shortest == NULL || posting->count < shortest->count) {
+            shortest = posting;
+        }
+    }
+
+    *count = 0;
+    *ids = mem_calloc(MEM_RESULT, shortest != NULL && shortest->count > 0 ? shortest->count : 1, sizeof(uint64_t));
+    if (*ids == NULL) {
+        return false;
+    }
+    if (shortest != NULL) {
+        for (uint64_t i = 0; i < shortest->capacity; i++) {
+            if (shortest->ids[i] != 0 && shortest->ids[i] != removed_id) {
+                (*ids)[(*count)++] = shortest->ids[i];
+            }
+        }
+    }
+    LOG_C(LOG_DEBUG, "Name index gives [%llu] candidates for [%s].", *count, pattern)
+    return true;
+}
+
+/**
+ * @brief           判断姓名是否匹配查询串
+ * @param name      姓名
+ * @param pattern   查询串
+ * @param match     匹配方式
+ * @param distance  最大编辑距离[仅模糊匹配使用]
+ * @return          false表示不匹配，否则为匹配
+ */
+bool is_name_matched(const char *name, const char *pattern, name_match_t match, uint8_t distance) {
+    if (pattern == NULL) {
+        return true;
+    }
+    if (name == NULL) {
+        return false;
+    }
+
+    switch (match) {
+        case NAME_EXACT:
+            return strcmp(name, pattern) == 0;
+        case NAME_PREFIX:
+            return strncmp(name, pattern, strlen(pattern)) == 0;
+        case NAME_SUBSTR:
+            return strstr(name, pattern) != NULL;
+        case NAME_FUZZY:
+            return get_edit_distance(pattern, name) <= distance;
+
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,25 @@
+//
+//  name_index.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef name_index_h
+#define name_index_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "common.h"
+
+bool create_name_index(void);
+void delete_name_index(void);
+bool add_name_to_index(const char *name, uint64_t staff_id);
+void remove_name_from_index(const char *name, uint64_t staff_id);
+bool get_ids_from_name_index(const char *pattern, name_match_t match, uint8_t distance, uint64_t **ids, uint64_t *count);
+bool is_name_matched(const char *name, const char *pattern, name_match_t match, uint8_t distance);
+uint32_t get_edit_distance(const char *src, const char *dst);
+
+#endif /* name_index_h */
@@ -0,0 +1,345 @@
+//
+//  query_cache.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "query_cache.h"
+#include "database_manager.h"
+#include "log.h"
+#include "mem_stat.h"
+#include <string.h>
+#include <pthread.h>
+
+#define CACHE_SET_COUNT     16  // 缓存组数量
+#define CACHE_WAY_COUNT     4   // 每组缓存路数
+#define RECORD_SET_COUNT    256 // 热点记录缓存组数量
+#define RECORD_WAY_COUNT    8   // 热点记录缓存每组路数
+#define RECORD_TEXT_SIZE    160 // 单条记录渲染结果最大长度[更长的记录不缓存]
+
+/**
+ * @brief 查询缓存项
+ */
+typedef struct {
+    uint64_t hash;      // 查询键哈希值
+    uint64_t version;   // 缓存时数据库版本
+    uint64_t last_used; // 最近使用时刻[LRU淘汰依据]
+    char *key;          // 归一化查询键
+    char *result;       // 查询结果
+} cache_entry_t;
+
+/**
+ * @brief 热点记录缓存项
+ */
+typedef struct {
+    uint64_t staff_id;              // 工号[0表示空闲]
+    bool is_referenced;             // CLOCK访问标志[命中时置位，指针扫过时清除]
+    char text[RECORD_TEXT_SIZE];    // 渲染后的记录
+} record_entry_t;
+
+static cache_entry_t s_cache[CACHE_SET_COUNT][CACHE_WAY_COUNT];    // 组相联缓存
+static query_cache_stat_t s_cache_stat = {0};                       // 缓存统计
+static uint64_t s_cache_tick = 0;                                   // 访问计数
+static record_entry_t s_records[RECORD_SET_COUNT][RECORD_WAY_COUNT];    // 热点记录缓存[组内CLOCK淘汰]
+static uint8_t s_record_hands[RECORD_SET_COUNT] = {0};                  // 各组CLOCK指针
+static query_cache_stat_t s_record_stat = {0};                          // 热点记录缓存统计
+static pthread_mutex_t s_cache_lock = PTHREAD_MUTEX_INITIALIZER;        // 查询缓存锁[共享执行的查询会并发访问]
+static pthread_mutex_t s_record_lock = PTHREAD_MUTEX_INITIALIZER;       // 热点记录缓存锁
+
+/**
+ * @brief           生成归一化查询键[GET *与无过滤条件的GET视为同一查询，分页参数计入查询键]
+ * @param query     查询信息
+ * @param key       查询键缓存
+ * @param size      缓存大小
+ * @return          false表示查询键过长，否则为成功
+ */
+STATIC bool make_query_key(const query_info_t *query, char *key, size_t size) {
+    const staff_info_t *info = &query->info;
+    const sort_order_t *order = &query->sort_order;
+    uint32_t sort_code = 0;     // 排序规则编码[各字段4位，低3位为字段，高位为降序标志]
+    for (uint8_t i = 0; i < order->count; i++) {
+        sort_code = (sort_code << 4) | order->types[i] | (order->is_desc[i] << 3);
+    }
+    int len = snprintf(key, size, "%d\x1f%d:%d:%s\x1f%s\x1f%s\x1f%llu\x1f%u\x1f%llu\x1f%llu", query->command,
+        query->name_match, query->max_distance, info->name ? info->name : "", info->department ? info->department : "",
+        info->position ? info->position : "", info->date, sort_code, query->limit, query->offset);
+    return len > 0 && len < size;
+}
+
+/**
+ * @brief       计算查询键哈希值[FNV-1a]
+ * @param key   查询键
+ * @return      哈希值
+ */
+static uint64_t hash_query_key(const char *key) {
+    uint64_t hash = 14695981039346656037UL;
+    for (const char *ch = key; *ch != '\0'; ch++) {
+        hash ^= (uint8_t)*ch;
+        hash *= 1099511628211UL;
+    }
+    return hash;
+}
+
+/**
+ * @brief       清理缓存项
+ * @param entry 缓存项
+ */
+static void clear_cache_entry(cache_entry_t *entry) {
+    if (entry->key != NULL) {
+        s_cache_stat.entries--;
+    }
+    MEM_FREE(MEM_STRING, entry->key)
+    MEM_FREE(MEM_RESULT, entry->result)
+    entry->hash = 0;
+    entry->version = 0;
+    entry->last_used = 0;
+}
+
+/**
+ * @brief           查找查询缓存[命中时结果追加至请求，不截断]
+ * @param query     查询信息
+ * @param request   原始请求
+ * @return          false表示未命中，否则为命中
+ */
+bool get_query_cache(const query_info_t *query, user_request_t *request) {
+    if (query == NULL || request == NULL) {
+        return false;
+    }
+
+    char key[BUFSIZ] = {'\0'};
+    bool is_valid = make_query_key(query, key, BUFSIZ);
+    pthread_mutex_lock(&s_cache_lock);
+    if (!is_valid) {
+        s_cache_stat.misses++;
+        pthread_mutex_unlock(&s_cache_lock);
+        return false;
+    }
+
+    uint64_t hash = hash_query_key(key);
+    cache_entry_t *set = s_cache[hash % CACHE_SET_COUNT];
+    for (uint8_t i = 0; i < CACHE_WAY_COUNT; i++) {
+        cache_entry_t *entry = &set[i];
+        if (entry->key == NULL || entry->hash != hash || strcmp(entry->key, key) != 0) {
+            continue;
+        }
+        // 数据库版本变化表示数据已变更，缓存失效
+        if (entry->version != get_database_version()) {
+            clear_cache_entry(entry);
+            s_cache_stat.invalidations++;
+            break;
+        }
+        entry->last_used = ++s_cache_tick;
+        append_request_text(request, entry->result, strlen(entry->result));
+        s_cache_stat.hits++;
+        pthread_mutex_unlock(&s_cache_lock);
+        LOG_C(LOG_DEBUG, "Query cache hit, hash is [%llu].", hash)
+        return true;
+    }
+
+    s_cache_stat.misses++;
+    pthread_mutex_unlock(&s_cache_lock);
+    return false;
+}
+
+/**
+ * @brief           存储查询结果至缓存[超过CACHE_RESULT_SIZE的结果不缓存]
+ * @param query     查询信息
+ * @param result    查询结果
+ */
+void put_query_cache(const query_info_t *query, const char *result) {
+    if (query == NULL || result == NULL) {
+        return;
+    }
+    size_t result_len = strnlen(result, CACHE_RESULT_SIZE + 1);
+    if (result_len > CACHE_RESULT_SIZE) {
+        LOG_C(LOG_DEBUG, "Query result is too large to cache.")
+        return;
+    }
+
+    char key[BUFSIZ] = {'\0'};
+    if (!make_query_key(query, key, BUFSIZ)) {
+        return;
+    }
+
+    uint64_t hash = hash_query_key(key);
+    pthread_mutex_lock(&s_cache_lock);
+    cache_entry_t *set = s_cache[hash % CACHE_SET_COUNT];
+    cache_entry_t *victim = &set[0];
+    for (uint8_t i = 0; i < CACHE_WAY_COUNT; i++) {
+        cache_entry_t *entry = &set[i];
+        // 优先复用同键或空闲缓存项，否则淘汰最久未使用项
+        if (entry->key == NULL || (entry->hash == hash && strcmp(entry->key, key) == 0)) {
+            victim = entry;
+            break;
+        }
+        if (entry->last_used < victim->last_used) {
+            victim = entry;
+        }
+    }
+    if (victim->key != NULL && (victim->hash != hash || strcmp(victim->key, key) != 0)) {
+        s_cache_stat.evictions++;
+    }
+    clear_cache_entry(victim);
+
+    victim->key = mem_strndup(MEM_STRING, key, strlen(key));
+    victim->result = mem_strndup(MEM_RESULT, result, result_len);
+    if (victim->key == NULL || victim->result == NULL) {
+        MEM_FREE(MEM_STRING, victim->key)
+        MEM_FREE(MEM_RESULT, victim->result)
+        pthread_mutex_unlock(&s_cache_lock);
+        return;
+    }
+    victim->hash = hash;
+    victim->version = get_database_version();
+    victim->last_used = ++s_cache_tick;
+    s_cache_stat.entries++;
+    pthread_mutex_unlock(&s_cache_lock);
+}
+
+/**
+ * @brief 清空查询缓存
+ */
+void clear_query_cache(void) {
+    pthread_mutex_lock(&s_cache_lock);
+    for (uint8_t i = 0; i < CACHE_SET_COUNT; i++) {
+        for (uint8_t j = 0; j < CACHE_WAY_COUNT; j++) {
+            clear_cache_entry(&s_cache[i][j]);
+        }
+    }
+    pthread_mutex_unlock(&s_cache_lock);
+    invalidate_record_cache(0);
+}
+
+/**
+ * @brief       获取查询缓存统计信息
+ * @param stat  统计信息存放地址
+ */
+void get_query_cache_stat(query_cache_stat_t *stat) {
+    if (stat == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&s_cache_lock);
+    *stat = s_cache_stat;
+    pthread_mutex_unlock(&s_cache_lock);
+    stat->capacity = CACHE_SET_COUNT * CACHE_WAY_COUNT;
+}
+
+/**
+ * @brief           获取工号所属热点记录缓存组
+ * @param staff_id  工号
+ * @return          缓存组序号
+ */
+static inline uint32_t get_record_set(uint64_t staff_id) {
+    return (uint32_t)((staff_id * 11400714819323198549UL) >> 56) % RECORD_SET_COUNT;
+}
+
+/**
+ * @brief           查找热点记录缓存
+ * @param staff_id  工号
+ * @param request   原始请求[命中时追加缓存结果]
+ * @return          false表示未命中，否则为命中
+ */
+bool get_record_cache(uint64_t staff_id, user_request_t *request) {
+    if (staff_id == 0 || request == NULL) {
+        return false;
+    }
+
+    record_entry_t *set = s_records[get_record_set(staff_id)];
+    pthread_mutex_lock(&s_record_lock);
+    for (uint8_t i = 0; i < RECORD_WAY_COUNT; i++) {
+        if (set[i].staff_id == staff_id) {
+            set[i].is_referenced = true;
+            append_request_text(request, set[i].text, strlen(set[i].text));
+            s_record_stat.hits++;
+            pthread_mutex_unlock(&s_record_lock);
+            return true;
+        }
+    }
+    s_record_stat.misses++;
+    pthread_mutex_unlock(&s_record_lock);
+    return false;
+}
+
+/**
+ * @brief           存储渲染后的记录至热点记录缓存[组满时按CLOCK淘汰最近未访问项]
+ * @param staff_id  工号
+ * @param result    渲染结果
+ */
+void put_record_cache(uint64_t staff_id, const char *result) {
+    if (staff_id == 0 || result == NULL || strlen(result) >= RECORD_TEXT_SIZE) {
+        return;
+    }
+
+    uint32_t set_index = get_record_set(staff_id);
+    record_entry_t *set = s_records[set_index];
+    record_entry_t *victim = NULL;
+    pthread_mutex_lock(&s_record_lock);
+    for (uint8_t i = 0; i < RECORD_WAY_COUNT && victim == NULL; i++) {
+        if (set[i].staff_id == staff_id || set[i].staff_id == 0) {
+            victim = &set[i];
+        }
+    }
+    // 指针扫过的已访问项获得第二次机会，首个未访问项被淘汰
+    while (victim == NULL) {
+        record_entry_t *entry = &set[s_record_hands[set_index]];
+        s_record_hands[set_index] = (s_record_hands[set_index] + 1) % RECORD_WAY_COUNT;
+        if (!entry->is_referenced) {
+            victim = entry;
+            s_record_stat.evictions++;
+        }
+        entry->is_referenced = false;
+    }
+
+    if (victim->staff_id == 0) {
+        s_record_stat.entries++;
+    }
+    victim->staff_id = staff_id;
+    victim->is_referenced = false;
+    strlcpy(victim->text, result, RECORD_TEXT_SIZE);
+    pthread_mutex_unlock(&s_record_lock);
+}
+
+/**
+ * @brief           热点记录缓存失效[员工修改或删除时由数据库回调]
+ * @param staff_id  工号[0表示全部失效]
+ */
+void invalidate_record_cache(uint64_t staff_id) {
+    pthread_mutex_lock(&s_record_lock);
+    for (uint32_t i = 0; i < RECORD_SET_COUNT; i++) {
+        if (staff_id != 0 && i != get_record_set(staff_id)) {
+            continue;
+        }
+        for (uint8_t j = 0; j < RECORD_WAY_COUNT; j++) {
+            record_entry_t *entry = &s_records[i][j];
+            if (entry->staff_id != 0 && (staff_id == 0 || entry->staff_id == staff_id)) {
+                entry->staff_id = 0;
+                entry->is_referenced = false;
+                s_record_stat.entries--;
+                s_record_stat.invalidations++;
+            }
+        }
+    }
+    pthread_mutex_unlock(&s_record_lock);
+}
+
+/**
+ * @brief       获取热点记录缓存统计信息
+ * @param stat  统计信息存放地址
+ */
+void get_record_cache_stat(query_cache_stat_t *stat) {
+    if (stat == NULL) {
+        return;
+    }
+    pthread_mutex_lock(&s_record_lock);
+    *stat = s_record_stat;
+    pthread_mutex_unlock(&s_record_lock);
+    stat->capacity = RECORD_SET_COUNT * RECORD_WAY_COUNT;
+}
+
+/**
+ * @brief 注册员工变更回调，使热点记录缓存随修改及删除失效
+ */
+__attribute__((constructor)) static void init_record_cache(void) {
+    set_database_change_callback(invalidate_record_cache);
+}
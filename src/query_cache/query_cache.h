@@ -0,0 +1,38 @@
+//
+//  query_cache.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef query_cache_h
+#define query_cache_h
+
+#include "command_execution.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+#define CACHE_RESULT_SIZE   (1 << 16)   // 单条查询结果最大缓存长度[更长的结果不缓存]
+
+/**
+ * @brief 查询缓存统计信息
+ */
+typedef struct {
+    uint64_t hits;          // 命中次数
+    uint64_t misses;        // 未命中次数
+    uint64_t evictions;     // 淘汰次数
+    uint64_t invalidations; // 因数据变更失效次数
+    uint32_t entries;       // 有效缓存数量
+    uint32_t capacity;      // 缓存容量
+} query_cache_stat_t;
+
+bool get_query_cache(const query_info_t *query, user_request_t *request);
+void put_query_cache(const query_info_t *query, const char *result);
+void clear_query_cache(void);
+void get_query_cache_stat(query_cache_stat_t *stat);
+bool get_record_cache(uint64_t staff_id, user_request_t *request);
+void put_record_cache(uint64_t staff_id, const char *result);
+void invalidate_record_cache(uint64_t staff_id);
+void get_record_cache_stat(query_cache_stat_t *stat);
+
+#endif /* query_cache_h */
@@ -0,0 +1,761 @@
+//
+//  replication.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "replication.h"
+#include "command_execution.h"
+#include "database_manager.h"
+#include "log.h"
+#include "mem_stat.h"
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <stdatomic.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+static const uint8_t max_followers = 8;         // 最大跟随者数量
+static const uint16_t null_length = 0xFFFF;     // 空字符串长度标识
+static const uint32_t send_buffer_size = 65536; // 快照发送缓冲大小
+static const uint32_t recv_chunk_size = 65536;  // 单次接收字节数
+static const int follower_send_buffer = 1 << 22;    // 跟随者套接字发送缓冲[积压超出时移除跟随者]
+
+/**
+ * @brief 复制帧头[本机回环传输，采用主机字节序]
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t size;          // 帧总长度[含帧头及字符串]
+    uint8_t op;             // 复制操作
+    uint64_t sequence;      // 变更序号
+    uint64_t timestamp;     // 主节点提交时间[毫秒]
+    uint64_t staff_id;      // 工号
+    uint64_t date;          // 入职日期
+    uint16_t lengths[3];    // 姓名、部门、职位长度[null_length表示NULL，字符串以'\0'结尾]
+} repl_frame_t;
+
+/**
+ * @brief 帧发送缓冲
+ */
+typedef struct {
+    int fd;         // 目标描述符
+    char *data;     // 缓冲数据
+    uint32_t size;  // 已缓冲字节数
+    bool is_failed; // 发送失败标志
+} repl_writer_t;
+
+static repl_role_t s_role = REPL_NONE;          // 复制角色
+static int s_listen_fd = -1;                    // 主节点监听描述符
+static int s_primary_fd = -1;                   // 跟随者连接主节点描述符
+static int s_followers[max_followers] = {0};    // 主节点跟随者描述符[-1表示空闲]
+static uint32_t s_follower_count = 0;           // 主节点跟随者数量
+static pthread_mutex_t s_follower_lock = PTHREAD_MUTEX_INITIALIZER;    // 跟随者列表锁[推送与断开检测互斥，无需指令执行权]
+static atomic_ullong s_sequence = 0;            // 已提交或已应用序号
+static atomic_ullong s_lag_ms = 0;              // 最近应用变更延迟
+static atomic_bool s_is_synced = false;         // 跟随者快照完成标志
+static char *s_recv_buffer = NULL;              // 跟随者接收缓冲
+static uint64_t s_recv_size = 0;                // 接收缓冲已用字节数
+static uint64_t s_recv_capacity = 0;            // 接收缓冲容量
+static bool s_is_batching = false;              // 主节点批处理进行中[变更暂存至提交]
+static bool s_is_batch_failed = false;          // 批处理暂存失败标志
+static uint64_t s_batch_sequence = 0;           // 批处理开始前已提交序号
+static char *s_batch_data = NULL;               // 批处理暂存帧
+static uint32_t s_batch_size = 0;               // 批处理暂存字节数
+static uint32_t s_batch_capacity = 0;           // 批处理暂存容量
+
+/**
+ * @brief   获取当前时间
+ * @return  毫秒时间戳
+ */
+STATIC uint64_t get_current_ms(void) {
+    struct timeval now = {0};
+    gettimeofday(&now, NULL);
+    return (uint64_t)now.tv_sec * 1000 + now.tv_usec / 1000;
+}
+
+/**
+ * @brief       发送全部数据
+ * @param fd    目标描述符
+ * @param data  数据
+ * @param size  数据大小
+ * @return      false表示失败，否则成功
+ */
+STATIC bool send_all(int fd, const char *data, uint64_t size) {
+    while (size > 0) {
+        ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+/**
+ * @brief       计算字符串编码长度
+ * @param str   字符串
+ * @return      编码长度[null_length表示NULL]
+ */
+STATIC uint16_t get_encoded_length(const char *str) {
+    if (str == NULL) {
+        return null_length;
+    }
+    size_t length = strlen(str);
+    return length < null_length ? (uint16_t)length : null_length - 1;
+}
+
+/**
+ * @brief           编码复制帧
+ * @param op        复制操作
+ * @param sequence  变更序号
+ * @param info      员工信息[可为NULL]
+ * @param output    输出缓冲[为NULL时仅计算长度]
+ * @return          帧总长度
+ */
+STATIC uint32_t encode_frame(repl_op_t op, uint64_t sequence, const staff_info_t *info, char *output) {
+    repl_frame_t frame = {
+        .size = sizeof(repl_frame_t),
+        .op = op,
+        .sequence = sequence,
+        .timestamp = get_current_ms(),
+        .staff_id = info != NULL ? info->staff_id : 0,
+        .date = info != NULL ? info->date : 0,
+        .lengths = {null_length, null_length, null_length}
+    };
+    const char *strs[3] = {NULL};
+    if (info != NULL) {
+        strs[0] = info->name;
+        strs[1] = info->department;
+        strs[2] = info->position;
+    }
+    for (uint8_t i = 0; i < 3; i++) {
+        frame.lengths[i] = get_encoded_length(strs[i]);
+        frame.size += frame.lengths[i] == null_length ? 0 : frame.lengths[i] + 1;
+    }
+    if (output == NULL) {
+        return frame.size;
+    }
+
+    memcpy(output, &frame, sizeof(repl_frame_t));
+    output += sizeof(repl_frame_t);
+    for (uint8_t i = 0; i < 3; i++) {
+        if (frame.lengths[i] == null_length) {
+            continue;
+        }
+        memcpy(output, strs[i], frame.lengths[i]);
+        output[frame.lengths[i]] = '\0';
+        output += frame.lengths[i] + 1;
+    }
+    return frame.size;
+}
+
+/**
+ * @brief           刷新发送缓冲
+ * @param writer    发送缓冲
+ */
+STATIC void flush_writer(repl_writer_t *writer) {
+    if (!writer->is_failed && writer->size > 0) {
+        writer->is_failed = !send_all(writer->fd, writer->data, writer->size);
+    }
+    writer->size = 0;
+}
+
+/**
+ * @brief           写入复制帧至发送缓冲
+ * @param writer    发送缓冲
+ * @param op        复制操作
+ * @param sequence  变更序号
+ * @param info      员工信息[可为NULL]
+ */
+STATIC void write_frame(repl_writer_t *writer, repl_op_t op, uint64_t sequence, const staff_info_t *info) {
+    uint32_t size = encode_frame(op, sequence, info, NULL);
+    if (writer->size + size > send_buffer_size) {
+        flush_writer(writer);
+    }
+    encode_frame(op, sequence, info, writer->data + writer->size);
+    writer->size += size;
+}
+
+/**
+ * @brief           快照单个员工[数据库遍历回调]
+ * @param info      员工信息
+ * @param context   发送缓冲
+ * @return          false表示发送失败终止遍历，否则继续
+ */
+STATIC bool snapshot_a_staff(const staff_info_t *info, void *context) {
+    repl_writer_t *writer = (repl_writer_t *)context;
+    write_frame(writer, REPL_OP_ADD, 0, info);
+    return !writer->is_failed;
+}
+
+/**
+ * @brief       移除跟随者[调用方持有跟随者列表锁]
+ * @param index 跟随者序号
+ */
+STATIC void drop_follower(uint8_t index) {
+    LOG_C(LOG_INFO, "Replication follower [%d] is disconnected.", s_followers[index])
+    close(s_followers[index]);
+    s_followers[index] = -1;
+    s_follower_count--;
+}
+
+/**
+ * @brief       推送帧数据至所有跟随者[不等待跟随者接收，发送缓冲已满的跟随者被移除]
+ * @param data      帧数据
+ * @param size      数据大小
+ * @param sequence  最后变更序号
+ */
+STATIC void send_to_followers(const char *data, uint32_t size, uint64_t sequence) {
+    pthread_mutex_lock(&s_follower_lock);
+    for (uint8_t i = 0; i < max_followers; i++) {
+        if (s_followers[i] == -1) {
+            continue;
+        }
+        ssize_t sent = send(s_followers[i], data, size, MSG_NOSIGNAL);
+        while (sent < 0 && errno == EINTR) {
+            sent = send(s_followers[i], data, size, MSG_NOSIGNAL);
+        }
+        if (sent != (ssize_t)size) {
+            LOG_C(LOG_INFO, "Replication follower [%d] falls behind at sequence [%llu].", s_followers[i], sequence)
+            drop_follower(i);
+        }
+    }
+    pthread_mutex_unlock(&s_follower_lock);
+}
+
+/**
+ * @brief           暂存批处理复制帧[调用方持有指令执行权]
+ * @param op        复制操作
+ * @param sequence  变更序号
+ * @param info      员工信息[可为NULL]
+ */
+STATIC void append_batch_frame(repl_op_t op, uint64_t sequence, const staff_info_t *info) {
+    uint32_t size = encode_frame(op, sequence, info, NULL);
+    if (s_is_batch_failed) {
+        return;
+    }
+    if (s_batch_size + size > s_batch_capacity) {
+        uint32_t capacity = s_batch_capacity == 0 ? send_buffer_size : s_batch_capacity;
+        while (capacity < s_batch_size + size) {
+            capacity *= 2;
+        }
+        char *data = mem_realloc(MEM_OTHER, s_batch_data, capacity);
+        if (data == NULL) {
+            s_is_batch_failed = true;
+            return;
+        }
+        s_batch_data = data;
+        s_batch_capacity = capacity;
+    }
+    s_batch_size += encode_frame(op, sequence, info, s_batch_data + s_batch_size);
+}
+
+/**
+ * @brief 释放批处理暂存帧
+ */
+STATIC void clear_batch_frames(void) {
+    MEM_FREE(MEM_OTHER, s_batch_data)
+    s_batch_size = 0;
+    s_batch_capacity = 0;
+    s_is_batch_failed = false;
+    s_is_batching = false;
+}
+
+/**
+ * @brief       创建主节点监听套接字[仅绑定本机回环地址]
+ * @param port  监听端口
+ * @return      false表示失败，否则成功
+ */
+STATIC bool listen_for_followers(uint16_t port) {
+    struct sockaddr_in addr = {0};
+    int option = 1;
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+
+    s_listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (s_listen_fd == -1) {
+        LOG_C(LOG_ERROR, "Error occured in creating replication socket.")
+        return false;
+    }
+    setsockopt(s_listen_fd, SOL_SOCKET, SO_REUSEADDR, &option, sizeof(option));
+    if (bind(s_listen_fd, (struct sockaddr *)&addr, sizeof(addr)) == -1 || listen(s_listen_fd, max_followers) == -1) {
+        LOG_C(LOG_ERROR, "Error occured in listening replication port [%u].", port)
+        close(s_listen_fd);
+        s_listen_fd = -1;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief       连接主节点[仅连接本机回环地址]
+ * @param port  主节点复制端口
+ * @return      false表示失败，否则成功
+ */
+STATIC bool connect_to_primary(uint16_t port) {
+    struct sockaddr_in addr = {0};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = htons(port);
+
+    s_primary_fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (s_primary_fd == -1) {
+        LOG_C(LOG_ERROR, "Error occured in creating replication socket.")
+        return false;
+    }
+    if (connect(s_primary_fd, (struct sockaddr *)&addr, sizeof(addr)) == -1) {
+        LOG_C(LOG_ERROR, "Error occured in connecting primary [127.0.0.1:%u].", port)
+        close(s_primary_fd);
+        s_primary_fd = -1;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief       应用单个复制帧[调用方持有指令执行权]
+ * @param frame 帧头
+ * @param data  帧字符串数据
+ */
+STATIC void apply_frame(const repl_frame_t *frame, char *data) {
+    staff_info_t info = {
+        .staff_id = frame->staff_id,
+        .date = frame->date
+    };
+    char **strs[3] = {&info.name, &info.department, &info.position};
+    for (uint8_t i = 0; i < 3; i++) {
+        if (frame->lengths[i] != null_length) {
+            *strs[i] = data;
+            data += frame->lengths[i] + 1;
+        }
+    }
+
+    switch (frame->op) {
+        case REPL_OP_ADD:
+            add_item_to_database(&info);
+            break;
+        case REPL_OP_DEL:
+            remove_item_from_database(info.staff_id);
+            break;
+        case REPL_OP_MOD:
+            modify_item_from_database(&info, false, NULL);
+            break;
+        case REPL_OP_SNAPSHOT_BEGIN:
+            atomic_store(&s_is_synced, false);
+            // fall through
+        case REPL_OP_CLEAR:
+            delete_database();
+            create_database();
+            break;
+        case REPL_OP_SNAPSHOT_END:
+            atomic_store(&s_is_synced, true);
+            LOG_C(LOG_INFO, "Replication snapshot is applied at sequence [%llu].", frame->sequence)
+            break;
+        case REPL_OP_BATCH_BEGIN:
+        case REPL_OP_BATCH_END:
+            break;
+        default:
+            LOG_C(LOG_ERROR, "Unknown replication op [%u].", frame->op)
+            return;
+    }
+    if (frame->sequence != 0) {
+        uint64_t now = get_current_ms();
+        atomic_store(&s_sequence, frame->sequence);
+        atomic_store(&s_lag_ms, now > frame->timestamp ? now - frame->timestamp : 0);
+    }
+}
+
+/**
+ * @brief       校验复制帧[帧长须与帧头及各字符串长度之和一致，字符串须在帧内以'\0'结尾]
+ * @param frame 帧头
+ * @param data  帧字符串数据[长度为帧长减帧头长度]
+ * @return      false表示帧损坏，否则合法
+ */
+STATIC bool validate_frame(const repl_frame_t *frame, const char *data) {
+    if (frame->op == REPL_OP_NONE || frame->op >= REPL_OP_MAX) {
+        return false;
+    }
+    uint32_t size = sizeof(repl_frame_t);
+    for (uint8_t i = 0; i < 3; i++) {
+        if (frame->lengths[i] == null_length) {
+            continue;
+        }
+        size += frame->lengths[i] + 1;
+        if (size > frame->size || data[size - sizeof(repl_frame_t) - 1] != '\0') {
+            return false;
+        }
+    }
+    return size == frame->size;
+}
+
+/**
+ * @brief       计算接收缓冲中可应用的字节数[不完整帧及未接收至结束帧的批处理留待下次接收，任一帧损坏则整个数据流视为损坏]
+ * @param ready 可应用字节数
+ * @return      false表示数据流损坏，否则成功
+ */
+STATIC bool get_ready_size(uint64_t *ready) {
+    uint64_t offset = 0;
+    bool is_in_batch = false;
+    *ready = 0;
+    while (s_recv_size - offset >= sizeof(repl_frame_t)) {
+        repl_frame_t frame;
+        memcpy(&frame, s_recv_buffer + offset, sizeof(repl_frame_t));
+        // 帧长上限为帧头加三个最长字符串，超出即视为损坏，避免按损坏帧长无限接收
+        if (frame.size < sizeof(repl_frame_t) || frame.size > sizeof(repl_frame_t) + 3 * (uint32_t)null_length) {
+            return false;
+        }
+        if (s_recv_size - offset < frame.size) {
+            break;
+        }
+        if (!validate_frame(&frame, s_recv_buffer + offset + sizeof(repl_frame_t))) {
+            return false;
+        }
+        offset += frame.size;
+        // 批处理不可嵌套，结束帧须与开始帧配对
+        if (frame.op == REPL_OP_BATCH_BEGIN || frame.op == REPL_OP_BATCH_END) {
+            if (is_in_batch != (frame.op == REPL_OP_BATCH_END)) {
+                return false;
+            }
+            is_in_batch = !is_in_batch;
+        }
+        if (!is_in_batch) {
+            *ready = offset;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief       初始化复制
+ * @param role  复制角色
+ * @param port  主节点复制端口[0表示不建立连接]
+ * @return      false表示失败，否则成功
+ */
+bool init_replication(repl_role_t role, uint16_t port) {
+    uninit_replication();
+    s_role = role;
+    pthread_mutex_lock(&s_follower_lock);
+    for (uint8_t i = 0; i < max_followers; i++) {
+        s_followers[i] = -1;
+    }
+    pthread_mutex_unlock(&s_follower_lock);
+    if (port == 0) {
+        return true;
+    }
+
+    bool is_success = true;
+    if (role == REPL_PRIMARY) {
+        is_success = listen_for_followers(port);
+    }
+    else if (role == REPL_FOLLOWER) {
+        is_success = connect_to_primary(port);
+    }
+    if (is_success) {
+        LOG_C(LOG_INFO, "Init replication successfully, port [%u].", port)
+    }
+    return is_success;
+}
+
+/**
+ * @brief 关闭复制连接
+ */
+void uninit_replication(void) {
+    pthread_mutex_lock(&s_follower_lock);
+    for (uint8_t i = 0; i < max_followers; i++) {
+        if (s_role == REPL_PRIMARY && s_followers[i] > 0) {
+            close(s_followers[i]);
+        }
+        s_followers[i] = -1;
+    }
+    s_follower_count = 0;
+    pthread_mutex_unlock(&s_follower_lock);
+    if (s_listen_fd != -1) {
+        close(s_listen_fd);
+        s_listen_fd = -1;
+    }
+    if (s_primary_fd != -1) {
+        close(s_primary_fd);
+        s_primary_fd = -1;
+    }
+    MEM_FREE(MEM_OTHER, s_recv_buffer)
+    s_recv_size = 0;
+    s_recv_capacity = 0;
+    clear_batch_frames();
+    s_role = REPL_NONE;
+    atomic_store(&s_sequence, 0);
+    atomic_store(&s_lag_ms, 0);
+    atomic_store(&s_is_synced, false);
+}
+
+/**
+ * @brief   是否为只读节点
+ * @return  true表示跟随者[仅支持查询]，否则可写
+ */
+bool is_replication_read_only(void) {
+    return s_role == REPL_FOLLOWER;
+}
+
+/**
+ * @brief               添加跟随者[持有执行权阻塞发送快照，期间无写入，之后以非阻塞方式推送增量]
+ * @param follower_fd   跟随者描述符
+ * @return              false表示失败，否则成功
+ */
+bool add_replication_follower(int follower_fd) {
+    if (s_role != REPL_PRIMARY || follower_fd < 0) {
+        return false;
+    }
+    int option = 1;
+#ifdef SO_NOSIGPIPE
+    setsockopt(follower_fd, SOL_SOCKET, SO_NOSIGPIPE, &option, sizeof(option));
+#endif
+    option = follower_send_buffer;
+    setsockopt(follower_fd, SOL_SOCKET, SO_SNDBUF, &option, sizeof(option));
+
+    acquire_command_gate(GATE_EXCLUSIVE);
+    int8_t index = -1;
+    pthread_mutex_lock(&s_follower_lock);
+    for (uint8_t i = 0; i < max_followers; i++) {
+        if (s_followers[i] == -1) {
+            index = i;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_follower_lock);
+    repl_writer_t writer = {
+        .fd = follower_fd,
+        .data = mem_malloc(MEM_OTHER, send_buffer_size)
+    };
+    if (index < 0 || writer.data == NULL) {
+        release_command_gate();
+        MEM_FREE(MEM_OTHER, writer.data)
+        LOG_C(LOG_ERROR, "Failed to add replication follower [%d].", follower_fd)
+        return false;
+    }
+
+    uint64_t sequence = atomic_load(&s_sequence);
+    write_frame(&writer, REPL_OP_SNAPSHOT_BEGIN, 0, NULL);
+    traverse_database(NULL, snapshot_a_staff, &writer);
+    write_frame(&writer, REPL_OP_SNAPSHOT_END, sequence, NULL);
+    flush_writer(&writer);
+    if (!writer.is_failed) {
+        fcntl(follower_fd, F_SETFL, fcntl(follower_fd, F_GETFL) | O_NONBLOCK);
+        pthread_mutex_lock(&s_follower_lock);
+        s_followers[index] = follower_fd;
+        s_follower_count++;
+        pthread_mutex_unlock(&s_follower_lock);
+        LOG_C(LOG_INFO, "Replication follower [%d] is added at sequence [%llu].", follower_fd, sequence)
+    }
+    release_command_gate();
+
+    MEM_FREE(MEM_OTHER, writer.data)
+    return !writer.is_failed;
+}
+
+/**
+ * @brief       推送变更至所有跟随者[调用方持有指令执行权；不等待跟随者接收，发送缓冲已满的跟随者被移除，重连后重新同步快照]
+ * @param op    复制操作
+ * @param info  变更后员工信息[DEL、CLEAR仅使用工号]
+ */
+void publish_replication(repl_op_t op, const staff_info_t *info) {
+    if (s_role != REPL_PRIMARY) {
+        return;
+    }
+    uint64_t sequence = atomic_fetch_add(&s_sequence, 1) + 1;
+    if (s_is_batching) {
+        append_batch_frame(op, sequence, info);
+        return;
+    }
+    pthread_mutex_lock(&s_follower_lock);
+    uint32_t followers = s_follower_count;
+    pthread_mutex_unlock(&s_follower_lock);
+    if (followers == 0) {
+        return;
+    }
+
+    uint32_t size = encode_frame(op, sequence, info, NULL);
+    char *data = mem_malloc(MEM_OTHER, size);
+    if (data == NULL) {
+        return;
+    }
+    encode_frame(op, sequence, info, data);
+    send_to_followers(data, size, sequence);
+    MEM_FREE(MEM_OTHER, data)
+}
+
+/**
+ * @brief 开始批处理复制[调用方持有指令执行权；此后变更暂存至结束批处理]
+ */
+void begin_replication_batch(void) {
+    if (s_role != REPL_PRIMARY) {
+        return;
+    }
+    clear_batch_frames();
+    s_is_batching = true;
+    s_batch_sequence = atomic_load(&s_sequence);
+    append_batch_frame(REPL_OP_BATCH_BEGIN, 0, NULL);
+}
+
+/**
+ * @brief               结束批处理复制[调用方持有指令执行权；提交时整体推送，否则丢弃暂存变更并恢复序号]
+ * @param is_committed  批处理是否提交成功
+ */
+void end_replication_batch(bool is_committed) {
+    if (!s_is_batching) {
+        return;
+    }
+    uint64_t sequence = atomic_load(&s_sequence);
+    if (!is_committed) {
+        atomic_store(&s_sequence, s_batch_sequence);
+    }
+    else if (sequence != s_batch_sequence) {
+        append_batch_frame(REPL_OP_BATCH_END, 0, NULL);
+        if (!s_is_batch_failed) {
+            send_to_followers(s_batch_data, s_batch_size, sequence);
+        }
+        else {
+            // 无法推送完整批处理，移除全部跟随者，重连后重新同步快照
+            pthread_mutex_lock(&s_follower_lock);
+            for (uint8_t i = 0; i < max_followers; i++) {
+                if (s_followers[i] != -1) {
+                    LOG_C(LOG_ERROR, "Failed to buffer replication batch at sequence [%llu].", sequence)
+                    drop_follower(i);
+                }
+            }
+            pthread_mutex_unlock(&s_follower_lock);
+        }
+    }
+    clear_batch_frames();
+}
+
+/**
+ * @brief               接收并应用主节点推送[不完整帧留待下次接收]
+ * @param primary_fd    主节点描述符
+ * @return              false表示连接断开，否则成功
+ */
+bool apply_replication_stream(int primary_fd) {
+    if (s_recv_capacity - s_recv_size < recv_chunk_size) {
+        uint64_t capacity = s_recv_size + recv_chunk_size;
+        char *buffer = mem_realloc(MEM_OTHER, s_recv_buffer, capacity);
+        if (buffer == NULL) {
+            return false;
+        }
+        s_recv_buffer = buffer;
+        s_recv_capacity = capacity;
+    }
+
+    ssize_t size = recv(primary_fd, s_recv_buffer + s_recv_size, recv_chunk_size, 0);
+    if (size <= 0) {
+        LOG_C(LOG_INFO, "Replication stream from primary is closed.")
+        return false;
+    }
+    s_recv_size += size;
+
+    uint64_t ready = 0;
+    if (!get_ready_size(&ready)) {
+        LOG_C(LOG_ERROR, "Replication stream is corrupted.")
+        return false;
+    }
+    if (ready == 0) {
+        return true;
+    }
+
+    uint64_t offset = 0;
+    acquire_command_gate(GATE_EXCLUSIVE);
+    while (offset < ready) {
+        repl_frame_t frame;
+        memcpy(&frame, s_recv_buffer + offset, sizeof(repl_frame_t));
+        apply_frame(&frame, s_recv_buffer + offset + sizeof(repl_frame_t));
+        offset += frame.size;
+    }
+    release_command_gate();
+
+    memmove(s_recv_buffer, s_recv_buffer + offset, s_recv_size - offset);
+    s_recv_size -= offset;
+    return true;
+}
+
+/**
+ * @brief           添加复制描述符至select集合
+ * @param fds       描述符集合
+ * @param max_fd    当前最大描述符
+ * @return          添加后最大描述符
+ */
+int set_replication_fds(fd_set *fds, int max_fd) {
+    int fds_list[max_followers + 2];
+    uint8_t count = 0;
+    fds_list[count++] = s_listen_fd;
+    fds_list[count++] = s_primary_fd;
+    pthread_mutex_lock(&s_follower_lock);
+    for (uint8_t i = 0; i < max_followers; i++) {
+        fds_list[count++] = s_role == REPL_PRIMARY ? s_followers[i] : -1;
+    }
+    pthread_mutex_unlock(&s_follower_lock);
+
+    for (uint8_t i = 0; i < count; i++) {
+        if (fds_list[i] != -1) {
+            FD_SET(fds_list[i], fds);
+            max_fd = max_fd < fds_list[i] ? fds_list[i] : max_fd;
+        }
+    }
+    return max_fd;
+}
+
+/**
+ * @brief       处理复制描述符事件[新跟随者、跟随者断开、主节点推送；跟随者断开检测仅持有跟随者列表锁]
+ * @param fds   select返回的描述符集合
+ */
+void process_replication_fds(fd_set *fds) {
+    if (s_listen_fd != -1 && FD_ISSET(s_listen_fd, fds)) {
+        int follower_fd = accept(s_listen_fd, NULL, NULL);
+        if (follower_fd != -1 && !add_replication_follower(follower_fd)) {
+            close(follower_fd);
+        }
+    }
+
+    if (s_role == REPL_PRIMARY) {
+        char discard[BUFSIZ];
+        pthread_mutex_lock(&s_follower_lock);
+        for (uint8_t i = 0; i < max_followers; i++) {
+            if (s_followers[i] == -1 || !FD_ISSET(s_followers[i], fds)) {
+                continue;
+            }
+            ssize_t size = recv(s_followers[i], discard, BUFSIZ, MSG_DONTWAIT);
+            if (size == 0 || (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                drop_follower(i);
+            }
+        }
+        pthread_mutex_unlock(&s_follower_lock);
+    }
+
+    if (s_primary_fd != -1 && FD_ISSET(s_primary_fd, fds) && !apply_replication_stream(s_primary_fd)) {
+        close(s_primary_fd);
+        s_primary_fd = -1;
+    }
+}
+
+/**
+ * @brief       获取复制统计
+ * @param stat  复制统计
+ */
+void get_replication_stat(repl_stat_t *stat) {
+    if (stat == NULL) {
+        return;
+    }
+    stat->role = s_role;
+    stat->is_connected = s_primary_fd != -1;
+    stat->is_synced = atomic_load(&s_is_synced);
+    pthread_mutex_lock(&s_follower_lock);
+    stat->followers = s_follower_count;
+    pthread_mutex_unlock(&s_follower_lock);
+    stat->sequence = atomic_load(&s_sequence);
+    stat->lag_ms = atomic_load(&s_lag_ms);
+    stat->buffered = s_recv_size;
+}
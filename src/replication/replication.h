@@ -0,0 +1,69 @@
+//
+//  replication.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef replication_h
+#define replication_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/select.h>
+#include "common.h"
+
+/**
+ * @brief 复制角色
+ */
+typedef enum {
+    REPL_NONE,      // 未开启复制
+    REPL_PRIMARY,   // 主节点[接受写入并向跟随者推送变更]
+    REPL_FOLLOWER,  // 跟随者[只读，应用主节点推送的变更]
+    REPL_MAX
+} repl_role_t;
+
+/**
+ * @brief 复制操作
+ */
+typedef enum {
+    REPL_OP_NONE,
+    REPL_OP_ADD,            // 新增员工
+    REPL_OP_DEL,            // 删除员工
+    REPL_OP_MOD,            // 修改员工
+    REPL_OP_CLEAR,          // 清空数据库
+    REPL_OP_SNAPSHOT_BEGIN, // 快照开始[跟随者清空数据库]
+    REPL_OP_SNAPSHOT_END,   // 快照结束[其后为增量变更]
+    REPL_OP_BATCH_BEGIN,    // 批处理开始[跟随者接收至结束帧后整体应用]
+    REPL_OP_BATCH_END,      // 批处理结束
+    REPL_OP_MAX
+} repl_op_t;
+
+/**
+ * @brief 复制统计
+ */
+typedef struct {
+    repl_role_t role;       // 复制角色
+    bool is_connected;      // 跟随者是否连接至主节点
+    bool is_synced;         // 跟随者是否已完成快照
+    uint32_t followers;     // 主节点当前跟随者数量
+    uint64_t sequence;      // 主节点已提交序号或跟随者已应用序号
+    uint64_t lag_ms;        // 跟随者最近应用变更距主节点提交的时间[毫秒]
+    uint64_t buffered;      // 跟随者已接收未应用字节数
+} repl_stat_t;
+
+bool init_replication(repl_role_t role, uint16_t port);
+void uninit_replication(void);
+bool is_replication_read_only(void);
+bool add_replication_follower(int follower_fd);
+void publish_replication(repl_op_t op, const staff_info_t *info);
+void begin_replication_batch(void);
+void end_replication_batch(bool is_committed);
+bool apply_replication_stream(int primary_fd);
+int set_replication_fds(fd_set *fds, int max_fd);
+void process_replication_fds(fd_set *fds);
+void get_replication_stat(repl_stat_t *stat);
+
+#endif /* replication_h */
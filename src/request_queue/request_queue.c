@@ -0,0 +1,269 @@
+//
+//  request_queue.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "request_queue.h"
+#include "thread_pool.h"
+#include "log.h"
+#include "mem_stat.h"
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+/**
+ * @brief 请求队列计数
+ */
+typedef struct {
+    atomic_uint_fast64_t submitted;     // 已提交数量
+    atomic_uint_fast64_t started;       // 已开始执行数量
+    atomic_uint_fast64_t completed;     // 已执行数量
+    atomic_uint_fast64_t max_depth;     // 最大排队数量
+    atomic_uint_fast64_t wait_ns;       // 累计排队时长[纳秒]
+    atomic_uint_fast64_t max_wait_ns;   // 最长排队时长[纳秒]
+    atomic_uint_fast64_t exec_ns;       // 累计执行时长[纳秒]
+    atomic_uint_fast64_t max_exec_ns;   // 最长执行时长[纳秒]
+} queue_counter_t;
+
+static thread_pool_t *s_worker_pools[PRIORITY_MAX] = {NULL};  // 各优先级工作线程池[任务队列有界，满时输入线程阻塞]
+static uint32_t s_queue_size = 0;                   // 各优先级队列容量
+static request_done_callback s_done_func = NULL;    // 请求完成回调
+static int s_notify_fds[2] = {-1, -1};              // 完成通知管道[工作线程写入，输入线程select读取]
+static pthread_mutex_t s_done_lock = PTHREAD_MUTEX_INITIALIZER;    // 完成队列锁
+static request_job_t *s_done_head = NULL;           // 完成队列队首
+static request_job_t *s_done_tail = NULL;           // 完成队列队尾
+static queue_counter_t s_counters[PRIORITY_MAX];    // 各优先级请求队列计数
+
+/**
+ * @brief       获取请求任务所属优先级
+ * @param job   请求任务
+ * @return      优先级
+ */
+static inline query_priority_t get_job_priority(const request_job_t *job) {
+    return job->query.priority < PRIORITY_MAX ? job->query.priority : PRIORITY_HIGH;
+}
+
+/**
+ * @brief       执行请求任务并交回输入线程[工作线程任务]
+ * @param arg   请求任务
+ */
+static void execute_request_job(void *arg) {
+    request_job_t *job = (request_job_t *)arg;
+    queue_counter_t *counter = &s_counters[get_job_priority(job)];
+    uint64_t start = get_monotonic_ns();
+    atomic_fetch_add(&counter->started, 1);
+    atomic_fetch_add(&counter->wait_ns, start - job->submit_ns);
+    update_atomic_maximum(&counter->max_wait_ns, start - job->submit_ns);
+
+    execute_input_command(&job->query, &job->request);
+
+    uint64_t exec = get_monotonic_ns() - start;
+    atomic_fetch_add(&counter->exec_ns, exec);
+    update_atomic_maximum(&counter->max_exec_ns, exec);
+    atomic_fetch_add(&counter->completed, 1);
+
+    pthread_mutex_lock(&s_done_lock);
+    job->next = NULL;
+    if (s_done_tail == NULL) {
+        s_done_head = job;
+    }
+    else {
+        s_done_tail->next = job;
+    }
+    s_done_tail = job;
+    pthread_mutex_unlock(&s_done_lock);
+    // 管道已满时输入线程必有未读通知，无需重试
+    char signal = 1;
+    if (write(s_notify_fds[1], &signal, 1) < 0) {
+        LOG_C(LOG_DEBUG, "Notify pipe is full, completion is already pending.")
+    }
+}
+
+/**
+ * @brief 交回全部已完成任务[输入线程调用]
+ */
+static void deliver_done_jobs(void) {
+    pthread_mutex_lock(&s_done_lock);
+    request_job_t *job = s_done_head;
+    s_done_head = NULL;
+    s_done_tail = NULL;
+    pthread_mutex_unlock(&s_done_lock);
+
+    while (job != NULL) {
+        request_job_t *next = job->next;
+        if (s_done_func != NULL) {
+            s_done_func(job);
+        }
+        else {
+            delete_request_job(&job);
+        }
+        job = next;
+    }
+}
+
+/**
+ * @brief               初始化请求队列[高优先级请求独占工作线程，不在低优先级扫描之后排队]
+ * @param worker_count  高优先级工作线程数量[低优先级取其一半，至少为1]
+ * @param queue_size    各优先级队列容量
+ * @param func          请求完成回调
+ * @return              false表示失败，否则为成功
+ */
+bool init_request_queue(uint32_t worker_count, uint32_t queue_size, request_done_callback func) {
+    if (s_worker_pools[PRIORITY_HIGH] != NULL || worker_count == 0 || queue_size == 0 || func == NULL) {
+        LOG_C(LOG_ERROR, "Failed to init request queue for invalid param.")
+        return false;
+    }
+    if (pipe(s_notify_fds) != 0) {
+        LOG_C(LOG_ERROR, "Failed to create notify pipe for request queue.")
+        return false;
+    }
+    fcntl(s_notify_fds[0], F_SETFL, fcntl(s_notify_fds[0], F_GETFL) | O_NONBLOCK);
+    fcntl(s_notify_fds[1], F_SETFL, fcntl(s_notify_fds[1], F_GETFL) | O_NONBLOCK);
+
+    s_worker_pools[PRIORITY_HIGH] = create_thread_pool(worker_count, queue_size);
+    s_worker_pools[PRIORITY_LOW] = create_thread_pool((worker_count + 1) / 2, queue_size);
+    if (s_worker_pools[PRIORITY_HIGH] == NULL || s_worker_pools[PRIORITY_LOW] == NULL) {
+        delete_thread_pool(&s_worker_pools[PRIORITY_HIGH]);
+        delete_thread_pool(&s_worker_pools[PRIORITY_LOW]);
+        close(s_notify_fds[0]);
+        close(s_notify_fds[1]);
+        s_notify_fds[0] = s_notify_fds[1] = -1;
+        return false;
+    }
+    s_queue_size = queue_size;
+    s_done_func = func;
+    LOG_C(LOG_INFO, "Init request queue with [%u] high and [%u] low priority workers successfully.",
+        get_thread_count(s_worker_pools[PRIORITY_HIGH]), get_thread_count(s_worker_pools[PRIORITY_LOW]))
+    return true;
+}
+
+/**
+ * @brief 释放请求队列[等待已提交请求执行完成并交回]
+ */
+void uninit_request_queue(void) {
+    if (s_worker_pools[PRIORITY_HIGH] == NULL) {
+        return;
+    }
+
+    for (query_priority_t i = PRIORITY_HIGH; i < PRIORITY_MAX; i++) {
+        delete_thread_pool(&s_worker_pools[i]);
+    }
+    deliver_done_jobs();
+    close(s_notify_fds[0]);
+    close(s_notify_fds[1]);
+    s_notify_fds[0] = s_notify_fds[1] = -1;
+    s_done_func = NULL;
+}
+
+/**
+ * @brief           创建请求任务
+ * @param input_fd  输入描述符
+ * @return          NULL表示失败，否则为成功
+ */
+request_job_t *create_request_job(uint8_t input_fd) {
+    request_job_t *job = mem_calloc(MEM_OTHER, 1, sizeof(request_job_t));
+    if (job == NULL) {
+        LOG_C(LOG_ERROR, "Failed to calloc resources for request job.")
+        return NULL;
+    }
+    job->request.input_fd = input_fd;
+    return job;
+}
+
+/**
+ * @brief       删除请求任务[同时释放查询信息及执行结果]
+ * @param job   请求任务
+ */
+void delete_request_job(request_job_t **job) {
+    if (job == NULL || *job == NULL) {
+        return;
+    }
+
+    request_job_t *request_job = *job;
+    clear_request_result(&request_job->request);
+    MEM_FREE(MEM_STRING, request_job->query.info.name)
+    MEM_FREE(MEM_STRING, request_job->query.info.position)
+    MEM_FREE(MEM_STRING, request_job->query.info.department)
+    MEM_FREE(MEM_STRING, request_job->query.export_path)
+    MEM_FREE(MEM_RESULT, request_job->query.staff_ids)
+    MEM_FREE(MEM_OTHER, request_job)
+    *job = NULL;
+}
+
+/**
+ * @brief       按优先级提交请求任务[队列满时阻塞等待]
+ * @param job   请求任务[成功后由完成回调负责释放]
+ * @return      false表示请求队列未启用或已停止，否则为成功
+ */
+bool submit_request_job(request_job_t *job) {
+    if (job == NULL || s_worker_pools[get_job_priority(job)] == NULL) {
+        return false;
+    }
+
+    query_priority_t priority = get_job_priority(job);
+    queue_counter_t *counter = &s_counters[priority];
+    job->submit_ns = get_monotonic_ns();
+    uint64_t submitted = atomic_fetch_add(&counter->submitted, 1) + 1;
+    uint64_t started = atomic_load(&counter->started);
+    update_atomic_maximum(&counter->max_depth, submitted > started ? submitted - started : 0);
+    if (!submit_thread_task(s_worker_pools[priority], execute_request_job, job)) {
+        atomic_fetch_sub(&counter->submitted, 1);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief           设置完成通知描述符
+ * @param fds       描述符集
+ * @param max_fd    当前最大描述符
+ * @return          新的最大描述符
+ */
+int set_request_queue_fds(fd_set *fds, int max_fd) {
+    if (s_notify_fds[0] < 0 || fds == NULL) {
+        return max_fd;
+    }
+    FD_SET(s_notify_fds[0], fds);
+    return s_notify_fds[0] > max_fd ? s_notify_fds[0] : max_fd;
+}
+
+/**
+ * @brief       处理完成通知，将已完成请求交回完成回调
+ * @param fds   select返回的描述符集
+ */
+void process_request_queue_fds(fd_set *fds) {
+    if (s_notify_fds[0] < 0 || fds == NULL || !FD_ISSET(s_notify_fds[0], fds)) {
+        return;
+    }
+
+    char signals[64];
+    while (read(s_notify_fds[0], signals, sizeof(signals)) > 0);
+    deliver_done_jobs();
+}
+
+/**
+ * @brief           获取请求队列统计
+ * @param priority  优先级
+ * @param stat      统计信息存放地址
+ */
+void get_request_queue_stat(query_priority_t priority, request_queue_stat_t *stat) {
+    if (priority >= PRIORITY_MAX || stat == NULL) {
+        return;
+    }
+    queue_counter_t *counter = &s_counters[priority];
+    uint64_t submitted = atomic_load(&counter->submitted);
+    uint64_t started = atomic_load(&counter->started);
+    stat->workers = get_thread_count(s_worker_pools[priority]);
+    stat->capacity = s_worker_pools[priority] != NULL ? s_queue_size : 0;
+    stat->depth = submitted > started ? submitted - started : 0;
+    stat->max_depth = atomic_load(&counter->max_depth);
+    stat->completed = atomic_load(&counter->completed);
+    stat->wait_us = atomic_load(&counter->wait_ns) / 1000;
+    stat->max_wait_us = atomic_load(&counter->max_wait_ns) / 1000;
+    stat->exec_us = atomic_load(&counter->exec_ns) / 1000;
+    stat->max_exec_us = atomic_load(&counter->max_exec_ns) / 1000;
+}
@@ -0,0 +1,54 @@
+//
+//  request_queue.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef request_queue_h
+#define request_queue_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/select.h>
+#include "command_execution.h"
+
+/**
+ * @brief 请求任务[输入线程解析后提交，工作线程执行，完成后交回输入线程发送结果]
+ */
+typedef struct request_job {
+    query_info_t query;         // 查询信息
+    user_request_t request;     // 用户请求及执行结果
+    uint64_t submit_ns;         // 提交时刻[单调时钟纳秒]
+    struct request_job *next;   // 完成队列后继
+} request_job_t;
+
+typedef void (*request_done_callback)(request_job_t *job);  // 请求完成回调[在输入线程调用，须释放任务]
+
+/**
+ * @brief 请求队列统计[各优先级分别统计]
+ */
+typedef struct {
+    uint32_t workers;       // 工作线程数量[0表示未启用]
+    uint32_t capacity;      // 队列容量
+    uint64_t depth;         // 当前排队数量
+    uint64_t max_depth;     // 最大排队数量
+    uint64_t completed;     // 已执行数量
+    uint64_t wait_us;       // 累计排队时长[微秒]
+    uint64_t max_wait_us;   // 最长排队时长[微秒]
+    uint64_t exec_us;       // 累计执行时长[微秒]
+    uint64_t max_exec_us;   // 最长执行时长[微秒]
+} request_queue_stat_t;
+
+bool init_request_queue(uint32_t worker_count, uint32_t queue_size, request_done_callback func);
+void uninit_request_queue(void);
+request_job_t *create_request_job(uint8_t input_fd);
+void delete_request_job(request_job_t **job);
+bool submit_request_job(request_job_t *job);
+int set_request_queue_fds(fd_set *fds, int max_fd);
+void process_request_queue_fds(fd_set *fds);
+void get_request_queue_stat(query_priority_t priority, request_queue_stat_t *stat);
+
+#endif /* request_queue_h */
@@ -8,6 +8,7 @@
 #include <arpa/inet.h>
 #include <readline/readline.h>
 #include <readline/history.h>
+#include "common.h"
 #include "log.h"
 
 static struct sockaddr_in server_addr;  // 服务端地址
@@ -72,24 +73,28 @@ STATIC void process_input_message(char *input_msg, size_t size) {
 }
 
 /**
- * @brief               接收远程信息
+ * @brief               接收远程信息[直至收到结果结束标识]
  * @param output_msg    接收缓存
  * @param size          缓存大小
  */
 STATIC void receive_message(char *output_msg, size_t size) {
-    bzero(output_msg, size);
-    ssize_t msg_size = recv(server_fd, output_msg, size, 0);
+    ssize_t msg_size = 0;
 
-    if (msg_size < 0) {
-        LOG_C(LOG_ERROR, "Error occured in recviving message.")
-        return;
-    }
-    if (msg_size == 0) {
-        LOG_O("Server is exited, now quit.")
-        close(server_fd);
-        exit(0);
-    }
-    LOG_O("%s", output_msg)
+    do {
+        bzero(output_msg, size);
+        msg_size = recv(server_fd, output_msg, size - 1, 0);
+        if (msg_size < 0) {
+            LOG_C(LOG_ERROR, "Error occured in recviving message.")
+            return;
+        }
+        if (msg_size == 0) {
+            LOG_O("Server is exited, now quit.")
+            close(server_fd);
+            exit(0);
+        }
+        printf("%s", output_msg);
+    } while (output_msg[msg_size - 1] != result_end_flag);
+    LOG_O("")
 }
 
 /**
@@ -7,10 +7,16 @@
 
 #include "manager_server.h"
 #include "command_parser.h"
+#include "replication.h"
+#include "request_queue.h"
 #include "log.h"
+#include "mem_stat.h"
+#include <errno.h>
 #include <string.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <pthread.h>
+#include <stdatomic.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
@@ -24,7 +30,11 @@ static fd_set server_set = {0};             // 服务端描述符集
 static int server_fd = -1;                  // 服务端文件描述符
 static struct sockaddr_in server_addr;      // 服务端地址
 static int clients_fd[max_clients] = {0};   // 客户端文件描述符
+static bool clients_busy[max_clients] = {0};    // 客户端请求执行中[执行完成前不再读取，保证请求按序执行]
+static uint32_t server_workers = 0;         // 请求执行线程数量[0表示在输入线程直接执行]
 static pthread_t read_thread = NULL;        // 本地输入处理线程
+static int wake_fds[2] = {-1, -1};          // 唤醒管道[停止服务时写入，输入线程select读取]
+static atomic_bool is_stopping = false;     // 停止服务标志[由输入线程退出主循环后释放资源]
 
 /**
  * @brief   创建服务端套接字
@@ -80,12 +90,18 @@ STATIC bool is_server_message_available(void) {
     max_fd = max_fd < server_fd ? server_fd : max_fd;
 
     for (uint8_t i = 0; i < max_clients; ++i) {
-        if (clients_fd[i] != 0) {
+        if (clients_fd[i] != 0 && !clients_busy[i]) {
             FD_SET(clients_fd[i], &server_set);
             max_fd = max_fd < clients_fd[i] ? clients_fd[i] : max_fd;
         }
     }
-    
+    if (wake_fds[0] != -1) {
+        FD_SET(wake_fds[0], &server_set);
+        max_fd = max_fd < wake_fds[0] ? wake_fds[0] : max_fd;
+    }
+    max_fd = set_replication_fds(&server_set, max_fd);
+    max_fd = set_request_queue_fds(&server_set, max_fd);
+
     int result = select(max_fd + 1, &server_set, NULL, NULL, NULL);
     if (result < 0) {
         LOG_C(LOG_DEBUG, "Error occured in selecting server fd.")
@@ -101,49 +117,79 @@ STATIC bool is_server_message_available(void) {
 }
 
 /**
- * @brief           发送查询结果
+ * @brief           发送查询结果[附带结束标识，部分发送时继续发送剩余部分，发送缓冲区满时阻塞等待对端接收]
  * @param client_fd 客户端fd
  * @param result    查询结果
+ * @param length    结果长度[不含结束标识]
  */
-STATIC void send_query_result(uint8_t client_fd, char *result) {
-    if (!FD_ISSET(client_fd, &server_set) || result == NULL) {
+STATIC void send_query_result(uint8_t client_fd, const char *result, size_t length) {
+    if (client_fd == STDIN_FILENO || result == NULL) {
         return;
     }
-    send(client_fd, result, strlen(result), 0);
+
+    size_t offset = 0;
+    size_t total = length + sizeof(result_end_flag);
+    while (offset < total) {
+        ssize_t size = send(client_fd, result+offset, total-offset, MSG_NOSIGNAL);
+        if (size < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            LOG_C(LOG_ERROR, "Error occured in sending result, errno is [%d].", errno)
+            return;
+        }
+        offset += size;
+    }
+}
+
+/**
+ * @brief       输出请求结果并释放请求任务[亦为请求队列完成回调，在输入线程调用]
+ * @param job   请求任务
+ */
+STATIC void finish_user_query(request_job_t *job) {
+    uint8_t input_fd = job->request.input_fd;
+    if (input_fd == STDIN_FILENO) {
+        LOG_O("%s", get_request_result(&job->request))
+    }
+    else {
+        send_query_result(input_fd, get_request_result(&job->request), get_request_result_length(&job->request));
+        for (uint8_t i = 0; i < max_clients; i++) {
+            if (clients_fd[i] == input_fd) {
+                clients_busy[i] = false;
+            }
+        }
+    }
+    delete_request_job(&job);
 }
 
 /**
- * @brief           处理用户请求
+ * @brief           处理用户请求[远程请求解析后交由请求队列执行，队列未启用时直接执行]
  * @param input_msg 用户输入
  * @param input_fd  用户fd
+ * @return          true表示已提交至请求队列，结果由完成回调输出
  */
-STATIC void process_user_query(char *input_msg, uint8_t input_fd) {
+STATIC bool process_user_query(char *input_msg, uint8_t input_fd) {
     if (input_msg == NULL) {
-        return;
+        return false;
     }
 
-    query_info_t query_info = {0};      // 查询详情
-    user_request_t user_request = {0};
-    user_request.input_fd = input_fd;
-    strlcpy(user_request.request, input_msg, BUFSIZ);
-    if (!parse_user_input(user_request.request, &query_info)) {
-        snprintf(user_request.result, BUFSIZ, "Failed to parse user input for invalid command or info.");
-        goto END;
+    request_job_t *job = create_request_job(input_fd);
+    if (job == NULL) {
+        return false;
     }
-    
-    execute_input_command(&query_info, &user_request);
-
-END:
-    if (input_fd == STDIN_FILENO) {
-        LOG_O("%s", user_request.result)
+    strlcpy(job->request.request, input_msg, BUFSIZ);
+    if (!parse_user_input(job->request.request, input_fd, &job->query)) {
+        set_request_result(&job->request, "Failed to parse user input for invalid command or info.");
+        fail_command_batch(input_fd);
+    }
+    else if (input_fd != STDIN_FILENO && submit_request_job(job)) {
+        return true;
     }
     else {
-        send_query_result(input_fd, user_request.result);
+        execute_input_command(&job->query, &job->request);
     }
-
-    FREE(query_info.info.name)
-    FREE(query_info.info.position)
-    FREE(query_info.info.department)
+    finish_user_query(job);
+    return false;
 }
 
 /**
@@ -163,6 +209,11 @@ STATIC bool process_connect_request(void) {
         return false;
     }
     
+#ifdef SO_NOSIGPIPE
+    int option = 1;
+    setsockopt(temp_fd, SOL_SOCKET, SO_NOSIGPIPE, &option, sizeof(option));
+#endif
+
     int index = -1;
     for (uint8_t i = 0; i < max_clients; i++) {
         if (clients_fd[i] == 0) {
@@ -229,6 +280,7 @@ STATIC void process_remote_query(void) {
         }
         if (msg_size == 0) {
             LOG_C(LOG_INFO, "NO[%d] client is exited.", i)
+            clear_command_batch(clients_fd[i]);
             clients_fd[i] = 0;
             continue;
         }
@@ -238,49 +290,112 @@ STATIC void process_remote_query(void) {
 
         msg_size = msg_size > BUFSIZ ? BUFSIZ: msg_size;
         // LOG_O("client[%u]> %s", i, input_msg)
-        process_user_query(input_msg, clients_fd[i]);
+        clients_busy[i] = process_user_query(input_msg, clients_fd[i]);
         bzero(input_msg, BUFSIZ);
     }
 }
 
+/**
+ * @brief       设置服务端绑定端口[须在初始化前调用]
+ * @param port  端口号[0表示使用默认端口]
+ */
+void set_server_port(uint16_t port) {
+    if (port != 0) {
+        server_port = port;
+    }
+}
+
+/**
+ * @brief       设置请求执行线程数量[须在初始化前调用]
+ * @param count 线程数量[0表示在输入线程直接执行]
+ */
+void set_server_workers(uint32_t count) {
+    server_workers = count;
+}
+
 /**
  * @brief   初始化服务端
  * @return  false表示失败，否则成功
  */
 bool init_socket_server(void) {
-    if (create_server_socket() && wait_for_connect()) {
+    atomic_store(&is_stopping, false);
+    if (create_server_socket() && wait_for_connect() && pipe(wake_fds) == 0) {
+        fcntl(wake_fds[0], F_SETFL, fcntl(wake_fds[0], F_GETFL) | O_NONBLOCK);
+        fcntl(wake_fds[1], F_SETFL, fcntl(wake_fds[1], F_GETFL) | O_NONBLOCK);
+        // 每个客户端至多一个请求在队列中，队列容量取最大客户端数量即不会阻塞输入线程
+        if (server_workers != 0 && !init_request_queue(server_workers, max_clients, finish_user_query)) {
+            close(server_fd);
+            return false;
+        }
         if (pthread_create(&read_thread, NULL, runloop_task, NULL) == 0)  {
             LOG_C(LOG_INFO, "Init socket successfully, ready for connecting.")
             return true;
         }
     }
     
+    uninit_request_queue();
     close(server_fd);
+    if (wake_fds[0] != -1) {
+        close(wake_fds[0]);
+        close(wake_fds[1]);
+        wake_fds[0] = wake_fds[1] = -1;
+    }
     return false;
 }
 
 /**
- * @brief 处理所有远程请求
+ * @brief   处理所有远程请求
+ * @return  false表示已请求停止服务，调用方应退出主循环并释放服务端
  */
-void process_all_requests(void) {
+bool process_all_requests(void) {
     if (!is_server_message_available()) {
-        return;
+        return !atomic_load(&is_stopping);
     }
 
     process_connect_request();
     process_remote_query();
+    process_replication_fds(&server_set);
+    process_request_queue_fds(&server_set);
+    if (wake_fds[0] != -1 && FD_ISSET(wake_fds[0], &server_set)) {
+        char signals[8];
+        while (read(wake_fds[0], signals, sizeof(signals)) > 0);
+    }
+    return !atomic_load(&is_stopping);
 }
 
 /**
- * @brief 断开所有连接
+ * @brief 请求停止服务[可在任意线程调用，唤醒输入线程退出主循环]
+ */
+void stop_socket_server(void) {
+    atomic_store(&is_stopping, true);
+    char signal = 1;
+    if (wake_fds[1] != -1 && write(wake_fds[1], &signal, 1) < 0) {
+        LOG_C(LOG_DEBUG, "Wake pipe is full, stopping is already pending.")
+    }
+}
+
+/**
+ * @brief 断开所有连接[须在输入线程调用，等待已提交请求执行完成]
  */
 void uninit_socket_server(void) {
     pthread_kill(read_thread, 0);
+    uninit_request_queue();
+    if (wake_fds[0] != -1) {
+        close(wake_fds[0]);
+        close(wake_fds[1]);
+        wake_fds[0] = wake_fds[1] = -1;
+    }
     for (uint8_t i = 0; i < max_clients; ++i) {
         if (clients_fd[i] != 0) {
             close(clients_fd[i]);
         }
+        clients_fd[i] = 0;
+        clients_busy[i] = false;
     }
     close(server_fd);
     server_fd = -1;
+    // 本地输入线程的变更指令可能正在推送复制
+    acquire_command_gate(GATE_EXCLUSIVE);
+    uninit_replication();
+    release_command_gate();
 }
@@ -11,9 +11,13 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 
+void set_server_port(uint16_t port);
+void set_server_workers(uint32_t count);
 bool init_socket_server(void);
-void process_all_requests(void);
+bool process_all_requests(void);
+void stop_socket_server(void);
 void uninit_socket_server(void);
 
 #endif /* manager_server_h */
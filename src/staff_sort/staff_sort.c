@@ -0,0 +1,584 @@
+//
+//  staff_sort.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "staff_sort.h"
+#include "database_manager.h"
+#include "thread_pool.h"
+#include "log.h"
+#include "mem_stat.h"
+#include <string.h>
+
+#define RADIX_BITS      8                       // 每趟基数排序位数
+#define RADIX_BUCKETS   (1 << RADIX_BITS)       // 每趟桶数量
+#define RADIX_PASSES    (64 / RADIX_BITS)       // 64位键最多排序趟数
+#define PREFIX_SIZE     sizeof(uint64_t)        // 字符串排序键前缀长度
+
+static const uint64_t small_sort_count = 32;            // 少于该数量时使用插入排序
+static const uint64_t parallel_sort_count = 1 << 16;    // 不少于该数量时并行基数排序
+
+/**
+ * @brief 排序键值对[键为当前字段归一化后的排序键，按键比较无需访问员工记录]
+ */
+typedef struct {
+    uint64_t key;           // 排序键
+    uint64_t index;         // 员工在原数组中的位置
+} sort_pair_t;
+
+/**
+ * @brief 基数排序分段任务[各分段独立统计及散列，分段间按序号拼接保证稳定]
+ */
+typedef struct {
+    staff_info_t **values;      // 员工信息数组[提取键及回写时使用]
+    staff_info_t **origins;     // 排序前员工信息数组[回写时按位置取用]
+    const sort_order_t *order;  // 排序规则
+    uint64_t *keys;             // 各员工归一化排序键[按员工连续存放，每员工order->count个]
+    sort_pair_t *src;           // 本趟输入
+    sort_pair_t *dst;           // 本趟输出
+    uint64_t begin;             // 分段起始位置
+    uint64_t end;               // 分段结束位置[不含]
+    uint8_t field;              // 本轮排序字段
+    uint8_t shift;              // 本趟键位移
+    uint8_t truncated_field;    // 分段内首个存在超出前缀长度字符串的字段[order->count表示无]
+    uint64_t counts[RADIX_PASSES][RADIX_BUCKETS];  // 各趟分段内各桶数量[散列时为本趟各桶写入位置]
+} radix_task_t;
+
+/**
+ * @brief           比较字符串字段[NULL视为空串]
+ * @param string1   字符串1
+ * @param string2   字符串2
+ * @return          比较结果
+ */
+static inline int compare_staff_string(const char *string1, const char *string2) {
+    return strcmp(string1 != NULL ? string1 : "", string2 != NULL ? string2 : "");
+}
+
+/**
+ * @brief           按排序规则逐字段比较员工
+ * @param staff1    员工1
+ * @param staff2    员工2
+ * @param order     排序规则
+ * @return          小于0表示员工1在前，大于0表示员工2在前，否则相等
+ */
+int compare_staffs(const staff_info_t *staff1, const staff_info_t *staff2, const sort_order_t *order) {
+    for (uint8_t i = 0; i < order->count; i++) {
+        int result = 0;
+        switch (order->types[i]) {
+            case SORT_ID:
+                result = (staff1->staff_id > staff2->staff_id) - (staff1->staff_id < staff2->staff_id);
+                break;
+            case SORT_DATE:
+                result = (staff1->date > staff2->date) - (staff1->date < staff2->date);
+                break;
+            case SORT_NAME:
+                result = compare_staff_string(staff1->name, staff2->name);
+                break;
+            case SORT_DEPT:
+                result = compare_staff_string(staff1->department, staff2->department);
+                break;
+            case SORT_POS:
+                result = compare_staff_string(staff1->position, staff2->position);
+                break;
+
+            default:
+                break;
+        }
+        if (result != 0) {
+            return order->is_desc[i] ? (result > 0 ? -1 : 1) : result;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief               提取字符串定长前缀[按大端序打包，与逐字节比较顺序一致]
+ * @param string        字符串
+ * @param is_truncated  存放是否超出前缀长度
+ * @return              前缀键
+ */
+static inline uint64_t get_string_prefix(const char *string, bool *is_truncated) {
+    uint64_t prefix = 0;
+    uint8_t i = 0;
+    for (; string != NULL && i < PREFIX_SIZE && string[i] != '\0'; i++) {
+        prefix |= (uint64_t)(uint8_t)string[i] << ((PREFIX_SIZE - 1 - i) * 8);
+    }
+    if (i == PREFIX_SIZE && string[i] != '\0') {
+        *is_truncated = true;
+    }
+    return prefix;
+}
+
+/**
+ * @brief               获取员工单个字段的归一化排序键[降序时按位取反]
+ * @param info          员工信息
+ * @param type          排序字段
+ * @param is_desc       是否降序
+ * @param is_truncated  存放字符串是否超出前缀长度
+ * @return              排序键
+ */
+static inline uint64_t get_sort_key(const staff_info_t *info, sort_type_t type, bool is_desc, bool *is_truncated) {
+    uint64_t key = 0;
+    switch (type) {
+        case SORT_ID:
+            key = info->staff_id;
+            break;
+        case SORT_DATE:
+            key = info->date;
+            break;
+        case SORT_NAME:
+            key = get_string_prefix(info->name, is_truncated);
+            break;
+        case SORT_DEPT:
+            key = get_string_prefix(info->department, is_truncated);
+            break;
+        case SORT_POS:
+            key = get_string_prefix(info->position, is_truncated);
+            break;
+
+        default:
+            break;
+    }
+    return is_desc ? ~key : key;
+}
+
+/**
+ * @brief       统计单个键各趟各桶数量
+ * @param task  基数排序分段任务
+ * @param key   排序键
+ */
+static inline void count_radix_key(radix_task_t *task, uint64_t key) {
+    for (uint8_t j = 0; j < RADIX_PASSES; j++) {
+        task->counts[j][(key >> (j * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+    }
+}
+
+/**
+ * @brief       提取分段所有字段的排序键，并统计末字段各趟各桶数量[线程池任务]
+ * @param arg   基数排序分段任务
+ */
+static void extract_radix_keys(void *arg) {
+    radix_task_t *task = (radix_task_t *)arg;
+    const sort_order_t *order = task->order;
+    memset(task->counts, 0, sizeof(task->counts));
+    for (uint64_t i = task->begin; i < task->end; i++) {
+        uint64_t *keys = task->keys + i * order->count;
+        for (uint8_t j = 0; j < order->count; j++) {
+            bool is_truncated = false;
+            keys[j] = get_sort_key(task->values[i], order->types[j], order->is_desc[j], &is_truncated);
+            if (is_truncated && j < task->truncated_field) {
+                task->truncated_field = j;
+            }
+        }
+        task->origins[i] = task->values[i];
+        task->src[i].key = keys[order->count - 1];
+        task->src[i].index = i;
+        count_radix_key(task, task->src[i].key);
+    }
+}
+
+/**
+ * @brief       按当前排列载入分段本轮字段的排序键，并统计各趟各桶数量[线程池任务]
+ * @param arg   基数排序分段任务
+ */
+static void load_radix_keys(void *arg) {
+    radix_task_t *task = (radix_task_t *)arg;
+    memset(task->counts, 0, sizeof(task->counts));
+    for (uint64_t i = task->begin; i < task->end; i++) {
+        task->src[i].key = task->keys[task->src[i].index * task->order->count + task->field];
+        count_radix_key(task, task->src[i].key);
+    }
+}
+
+/**
+ * @brief       统计分段本趟各桶数量[线程池任务]
+ * @param arg   基数排序分段任务
+ */
+static void count_radix_digits(void *arg) {
+    radix_task_t *task = (radix_task_t *)arg;
+    uint64_t *counts = task->counts[task->shift / RADIX_BITS];
+    memset(counts, 0, sizeof(uint64_t) * RADIX_BUCKETS);
+    for (uint64_t i = task->begin; i < task->end; i++) {
+        counts[(task->src[i].key >> task->shift) & (RADIX_BUCKETS - 1)]++;
+    }
+}
+
+/**
+ * @brief       按本趟各桶写入位置散列分段[线程池任务]
+ * @param arg   基数排序分段任务
+ */
+static void scatter_radix_digits(void *arg) {
+    radix_task_t *task = (radix_task_t *)arg;
+    uint64_t *offsets = task->counts[task->shift / RADIX_BITS];
+    for (uint64_t i = task->begin; i < task->end; i++) {
+        task->dst[offsets[(task->src[i].key >> task->shift) & (RADIX_BUCKETS - 1)]++] = task->src[i];
+    }
+}
+
+/**
+ * @brief       回写分段排序结果[线程池任务]
+ * @param arg   基数排序分段任务
+ */
+static void write_radix_values(void *arg) {
+    radix_task_t *task = (radix_task_t *)arg;
+    for (uint64_t i = task->begin; i < task->end; i++) {
+        task->values[i] = task->origins[task->src[i].index];
+    }
+}
+
+/**
+ * @brief           按排序规则插入排序[数量较少时使用，稳定]
+ * @param values    员工信息数组
+ * @param count     数组大小
+ * @param order     排序规则
+ */
+static void insertion_sort_staffs(staff_info_t **values, uint64_t count, const sort_order_t *order) {
+    for (uint64_t i = 1; i < count; i++) {
+        staff_info_t *value = values[i];
+        uint64_t j = i;
+        for (; j > 0 && compare_staffs(values[j - 1], value, order) > 0; j--) {
+            values[j] = values[j - 1];
+        }
+        values[j] = value;
+    }
+}
+
+/**
+ * @brief           按排序规则归并排序[稳定，用于前缀相同的员工]
+ * @param values    员工信息数组
+ * @param buffer    临时缓存[不少于count/2项]
+ * @param count     数组大小
+ * @param order     排序规则
+ */
+static void merge_sort_staffs(staff_info_t **values, staff_info_t **buffer, uint64_t count, const sort_order_t *order) {
+    if (count < small_sort_count) {
+        insertion_sort_staffs(values, count, order);
+        return;
+    }
+
+    uint64_t half = count / 2;
+    merge_sort_staffs(values, buffer, half, order);
+    merge_sort_staffs(values + half, buffer, count - half, order);
+    if (compare_staffs(values[half - 1], values[half], order) <= 0) {
+        return;
+    }
+
+    uint64_t i = 0, j = half, k = 0;
+    memcpy(buffer, values, sizeof(staff_info_t *) * half);
+    while (i < half && j < count) {
+        values[k++] = compare_staffs(values[j], buffer[i], order) < 0 ? values[j++] : buffer[i++];
+    }
+    while (i < half) {
+        values[k++] = buffer[i++];
+    }
+}
+
+/**
+ * @brief           大顶堆下沉调整
+ * @param values    堆数组
+ * @param count     堆大小
+ * @param index     待调整位置
+ * @param order     排序规则
+ */
+static void sift_down_staff(staff_info_t **values, uint64_t count, uint64_t index, const sort_order_t *order) {
+    while (true) {
+        uint64_t largest = index;
+        uint64_t left = index * 2 + 1;
+        uint64_t right = left + 1;
+        if (left < count && compare_staffs(values[left], values[largest], order) > 0) {
+            largest = left;
+        }
+        if (right < count && compare_staffs(values[right], values[largest], order) > 0) {
+            largest = right;
+        }
+        if (largest == index) {
+            break;
+        }
+        staff_info_t *temp = values[index];
+        values[index] = values[largest];
+        values[largest] = temp;
+        index = largest;
+    }
+}
+
+/**
+ * @brief           大顶堆上浮调整
+ * @param values    堆数组
+ * @param index     待调整位置
+ * @param order     排序规则
+ */
+static void sift_up_staff(staff_info_t **values, uint64_t index, const sort_order_t *order) {
+    while (index > 0) {
+        uint64_t parent = (index - 1) / 2;
+        if (compare_staffs(values[index], values[parent], order) <= 0) {
+            break;
+        }
+        staff_info_t *temp = values[index];
+        values[index] = values[parent];
+        values[parent] = temp;
+        index = parent;
+    }
+}
+
+/**
+ * @brief           按排序规则原地堆排序[无法申请排序缓存时使用]
+ * @param values    员工信息数组
+ * @param count     数组大小
+ * @param order     排序规则
+ */
+static void heap_sort_staffs(staff_info_t **values, uint64_t count, const sort_order_t *order) {
+    for (uint64_t i = count / 2; i > 0; i--) {
+        sift_down_staff(values, count, i - 1, order);
+    }
+    for (uint64_t i = count - 1; i > 0; i--) {
+        staff_info_t *temp = values[0];
+        values[0] = values[i];
+        values[i] = temp;
+        sift_down_staff(values, i, 0, order);
+    }
+}
+
+/**
+ * @brief           按单个字段的排序键逐趟散列[每趟8位，所有元素该位相同的趟跳过]
+ * @param tasks     分段任务[已统计该字段各趟各桶数量]
+ * @param parts     分段数量
+ * @param count     数组大小
+ * @param pool      线程池[NULL表示在当前线程执行]
+ * @param src       存放排序结果所在缓存[输入为当前排列]
+ * @param dst       存放另一缓存
+ */
+static void radix_sort_field(radix_task_t *tasks, uint32_t parts, uint64_t count, thread_pool_t *pool, sort_pair_t **src, sort_pair_t **dst) {
+    bool is_counted = true;     // 首个有效趟直接使用载入时的统计
+    for (uint8_t pass = 0; pass < RADIX_PASSES; pass++) {
+        uint64_t totals[RADIX_BUCKETS] = {0};
+        bool is_trivial = false;
+        // 各桶总数与排列无关，可由载入时的统计判断本趟是否所有元素位于同一桶
+        for (uint32_t i = 0; i < parts; i++) {
+            for (uint32_t j = 0; j < RADIX_BUCKETS; j++) {
+                totals[j] += tasks[i].counts[pass][j];
+            }
+        }
+        for (uint32_t j = 0; j < RADIX_BUCKETS && !is_trivial; j++) {
+            is_trivial = totals[j] == count;
+        }
+        if (is_trivial) {
+            continue;
+        }
+
+        for (uint32_t i = 0; i < parts; i++) {
+            tasks[i].src = *src;
+            tasks[i].dst = *dst;
+            tasks[i].shift = pass * RADIX_BITS;
+        }
+        if (!is_counted) {
+            run_thread_tasks(pool, count_radix_digits, tasks, sizeof(radix_task_t), parts);
+        }
+        is_counted = false;
+        // 按桶序再按分段序计算写入位置，保证稳定
+        uint64_t offset = 0;
+        for (uint32_t j = 0; j < RADIX_BUCKETS; j++) {
+            for (uint32_t i = 0; i < parts; i++) {
+                uint64_t bucket_count = tasks[i].counts[pass][j];
+                tasks[i].counts[pass][j] = offset;
+                offset += bucket_count;
+            }
+        }
+        run_thread_tasks(pool, scatter_radix_digits, tasks, sizeof(radix_task_t), parts);
+        sort_pair_t *temp = *src;
+        *src = *dst;
+        *dst = temp;
+    }
+}
+
+/**
+ * @brief           对截断字段及之前字段排序键均相同的连续员工按完整字段归并排序[前缀相同时截断字段及其后字段的顺序未定]
+ * @param values    已按排序键排列的员工信息数组
+ * @param count     数组大小
+ * @param pairs     排序结果[用于取得各员工排序键]
+ * @param keys      各员工归一化排序键
+ * @param order     排序规则
+ * @param field     首个存在超出前缀长度字符串的字段
+ * @param buffer    临时缓存[不少于count/2项]
+ */
+static void sort_truncated_runs(staff_info_t **values, uint64_t count, const sort_pair_t *pairs, const uint64_t *keys,
+    const sort_order_t *order, uint8_t field, staff_info_t **buffer) {
+    uint64_t begin = 0;
+    size_t size = sizeof(uint64_t) * (field + 1);
+    for (uint64_t i = 1; i <= count; i++) {
+        if (i < count && memcmp(keys + pairs[i].index * order->count, keys + pairs[begin].index * order->count, size) == 0) {
+            continue;
+        }
+        if (i - begin > 1) {
+            merge_sort_staffs(values + begin, buffer, i - begin, order);
+        }
+        begin = i;
+    }
+}
+
+/**
+ * @brief           分段LSD基数排序[每员工仅提取一次各字段排序键，按字段优先级由低至高逐字段稳定排序；
+ *                  字符串取8字节前缀，存在超出前缀长度的字符串时前缀相同的员工再按完整字段比较；分段数为1时即串行版本]
+ * @param values    员工信息数组
+ * @param count     数组大小
+ * @param order     排序规则
+ * @param pool      线程池[NULL表示在当前线程执行]
+ * @param parts     分段数量
+ * @return          false表示失败，否则为成功
+ */
+STATIC bool radix_sort_staffs(staff_info_t **values, uint64_t count, const sort_order_t *order, thread_pool_t *pool, uint32_t parts) {
+    parts = parts == 0 ? 1 : parts;
+    sort_pair_t *pairs = mem_malloc(MEM_RESULT, sizeof(sort_pair_t) * count * 2);
+    uint64_t *keys = mem_malloc(MEM_RESULT, sizeof(uint64_t) * count * order->count);
+    staff_info_t **origins = mem_malloc(MEM_RESULT, sizeof(staff_info_t *) * count);
+    radix_task_t *tasks = mem_calloc(MEM_RESULT, parts, sizeof(radix_task_t));
+    if (pairs == NULL || keys == NULL || origins == NULL || tasks == NULL) {
+        LOG_C(LOG_ERROR, "Failed to alloc resources for radix sort.")
+        MEM_FREE(MEM_RESULT, pairs)
+        MEM_FREE(MEM_RESULT, keys)
+        MEM_FREE(MEM_RESULT, origins)
+        MEM_FREE(MEM_RESULT, tasks)
+        return false;
+    }
+
+    sort_pair_t *src = pairs;
+    sort_pair_t *dst = pairs + count;
+    for (uint32_t i = 0; i < parts; i++) {
+        tasks[i].values = values;
+        tasks[i].origins = origins;
+        tasks[i].order = order;
+        tasks[i].keys = keys;
+        tasks[i].src = src;
+        tasks[i].truncated_field = order->count;
+        tasks[i].begin = count * i / parts;
+        tasks[i].end = count * (i + 1) / parts;
+    }
+    run_thread_tasks(pool, extract_radix_keys, tasks, sizeof(radix_task_t), parts);
+
+    uint8_t truncated_field = order->count;
+    for (uint8_t field = order->count; field > 0; field--) {
+        if (field != order->count) {
+            for (uint32_t i = 0; i < parts; i++) {
+                tasks[i].src = src;
+                tasks[i].field = field - 1;
+            }
+            run_thread_tasks(pool, load_radix_keys, tasks, sizeof(radix_task_t), parts);
+        }
+        radix_sort_field(tasks, parts, count, pool, &src, &dst);
+    }
+
+    for (uint32_t i = 0; i < parts; i++) {
+        tasks[i].src = src;
+        truncated_field = tasks[i].truncated_field < truncated_field ? tasks[i].truncated_field : truncated_field;
+    }
+    run_thread_tasks(pool, write_radix_values, tasks, sizeof(radix_task_t), parts);
+    // 另一半键值对缓存已不再使用，可作为归并缓存
+    if (truncated_field < order->count) {
+        sort_truncated_runs(values, count, src, keys, order, truncated_field, (staff_info_t **)dst);
+    }
+    MEM_FREE(MEM_RESULT, pairs)
+    MEM_FREE(MEM_RESULT, keys)
+    MEM_FREE(MEM_RESULT, origins)
+    MEM_FREE(MEM_RESULT, tasks)
+    return true;
+}
+
+/**
+ * @brief           员工信息数组按排序规则排序[基数排序，数量较多时由数据库扫描线程池并行排序]
+ * @param values    员工信息数组
+ * @param count     数组大小
+ * @param order     排序规则[NULL或字段数量为0表示无需排序]
+ */
+void sort_staffs(staff_info_t **values, uint64_t count, const sort_order_t *order) {
+    if (values == NULL || order == NULL || order->count == 0 || count < 2) {
+        return;
+    }
+    if (count < small_sort_count) {
+        insertion_sort_staffs(values, count, order);
+        return;
+    }
+
+    thread_pool_t *pool = count >= parallel_sort_count ? get_database_thread_pool() : NULL;
+    uint32_t parts = pool != NULL ? get_thread_count(pool) : 1;
+    if (!radix_sort_staffs(values, count, order, pool, parts)) {
+        heap_sort_staffs(values, count, order);
+    }
+}
+
+/**
+ * @brief           初始化前K项选择器
+ * @param selector  选择器
+ * @param capacity  最多选择数量
+ * @param order     排序规则
+ * @return          false表示失败，否则为成功
+ */
+bool init_staff_selector(staff_selector_t *selector, uint64_t capacity, const sort_order_t *order) {
+    if (selector == NULL || capacity == 0) {
+        return false;
+    }
+
+    selector->values = mem_calloc(MEM_RESULT, capacity, sizeof(staff_info_t *));
+    if (selector->values == NULL) {
+        LOG_C(LOG_ERROR, "Failed to calloc resources for selector.")
+        return false;
+    }
+    selector->count = 0;
+    selector->capacity = capacity;
+    selector->order = *order;
+    return true;
+}
+
+/**
+ * @brief           选择员工[可作为数据库遍历回调，复杂度O(logK)]
+ * @param info      员工信息
+ * @param selector  选择器
+ * @return          false表示无需继续遍历，否则为继续
+ */
+bool select_a_staff(const staff_info_t *info, void *selector) {
+    staff_selector_t *staff_selector = (staff_selector_t *)selector;
+    const sort_order_t *order = &staff_selector->order;
+    staff_info_t *value = (staff_info_t *)info;
+
+    // 无需排序时取前K项即可终止遍历
+    if (order->count == 0) {
+        staff_selector->values[staff_selector->count++] = value;
+        return staff_selector->count < staff_selector->capacity;
+    }
+
+    if (staff_selector->count < staff_selector->capacity) {
+        staff_selector->values[staff_selector->count] = value;
+        sift_up_staff(staff_selector->values, staff_selector->count, order);
+        staff_selector->count++;
+    }
+    // 仅当小于堆顶[当前第K项]时替换堆顶
+    else if (compare_staffs(value, staff_selector->values[0], order) < 0) {
+        staff_selector->values[0] = value;
+        sift_down_staff(staff_selector->values, staff_selector->count, 0, order);
+    }
+    return true;
+}
+
+/**
+ * @brief           结束选择，将已选择员工按排序规则排列
+ * @param selector  选择器
+ */
+void finish_staff_selector(staff_selector_t *selector) {
+    if (selector == NULL) {
+        return;
+    }
+    sort_staffs(selector->values, selector->count, &selector->order);
+}
+
+/**
+ * @brief           释放选择器
+ * @param selector  选择器
+ */
+void free_staff_selector(staff_selector_t *selector) {
+    if (selector == NULL) {
+        return;
+    }
+    MEM_FREE(MEM_RESULT, selector->values)
+    selector->count = 0;
+    selector->capacity = 0;
+}
@@ -0,0 +1,33 @@
+//
+//  staff_sort.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef staff_sort_h
+#define staff_sort_h
+
+#include "command_execution.h"
+#include <stdio.h>
+#include <stdbool.h>
+
+/**
+ * @brief 前K项选择器[有序时为大顶堆，无序时为顺序缓存]
+ */
+typedef struct {
+    staff_info_t **values;  // 已选择员工
+    uint64_t count;         // 已选择数量
+    uint64_t capacity;      // 最多选择数量
+    sort_order_t order;     // 排序规则
+} staff_selector_t;
+
+int compare_staffs(const staff_info_t *staff1, const staff_info_t *staff2, const sort_order_t *order);
+void sort_staffs(staff_info_t **values, uint64_t count, const sort_order_t *order);
+
+bool init_staff_selector(staff_selector_t *selector, uint64_t capacity, const sort_order_t *order);
+bool select_a_staff(const staff_info_t *info, void *selector);
+void finish_staff_selector(staff_selector_t *selector);
+void free_staff_selector(staff_selector_t *selector);
+
+#endif /* staff_sort_h */
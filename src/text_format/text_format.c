@@ -0,0 +1,233 @@
+//
+//  text_format.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "text_format.h"
+#include <string.h>
+#include <time.h>
+#include <stdatomic.h>
+
+#define DATE_CACHE_SIZE     4096    // 日期缓存项数量[按UTC日直接映射]
+
+static const uint32_t seconds_per_day = 86400;  // 每日秒数
+
+/**
+ * @brief 日期缓存项[缓存本地日期与UTC日的交集，以顺序锁保护，读取无需加锁]
+ */
+typedef struct {
+    _Atomic uint64_t sequence;  // 版本号[奇数表示正在写入]
+    _Atomic uint64_t begin;     // 有效区间起点
+    _Atomic uint64_t end;       // 有效区间终点[不含]
+    _Atomic uint64_t midnight;  // 本地当日零点对应时间戳
+    _Atomic uint64_t text[2];   // 日期文本[YYYY-MM-DD，按字节打包]
+} date_entry_t;
+
+static date_entry_t s_date_cache[DATE_CACHE_SIZE];  // 日期缓存
+
+/**
+ * @brief 两位十进制数字表[下标n*2处为n的两位文本]
+ */
+static const char s_digit_pairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * @brief           写入两位十进制数字[不足两位补0]
+ * @param buffer    写入位置
+ * @param number    数字[0-99]
+ */
+static inline void write_two_digits(char *buffer, uint32_t number) {
+    memcpy(buffer, s_digit_pairs + number * 2, 2);
+}
+
+/**
+ * @brief           格式化64位无符号整数[每次处理两位，不写入结尾'\0']
+ * @param buffer    写入位置[不少于UINT64_TEXT_SIZE字节]
+ * @param number    数字
+ * @return          写入长度
+ */
+size_t format_uint64(char *buffer, uint64_t number) {
+    char digits[UINT64_TEXT_SIZE];
+    char *cursor = digits + UINT64_TEXT_SIZE;
+    while (number >= 100) {
+        cursor -= 2;
+        write_two_digits(cursor, number % 100);
+        number /= 100;
+    }
+    if (number >= 10) {
+        cursor -= 2;
+        write_two_digits(cursor, (uint32_t)number);
+    }
+    else {
+        *--cursor = '0' + (char)number;
+    }
+
+    size_t length = digits + UINT64_TEXT_SIZE - cursor;
+    memcpy(buffer, cursor, length);
+    return length;
+}
+
+/**
+ * @brief           写入日期文本[YYYY-MM-DD]
+ * @param buffer    写入位置
+ * @param time      已拆分时间
+ */
+static void write_date(char *buffer, const struct tm *time) {
+    uint32_t year = time->tm_year + 1900;
+    write_two_digits(buffer, year / 100);
+    write_two_digits(buffer + 2, year % 100);
+    buffer[4] = '-';
+    write_two_digits(buffer + 5, time->tm_mon + 1);
+    buffer[7] = '-';
+    write_two_digits(buffer + 8, time->tm_mday);
+}
+
+/**
+ * @brief           按本地时区拆分时间[失败时各字段为0]
+ * @param date      时间戳
+ * @param time      存放地址
+ * @return          false表示无法转换，否则为成功
+ */
+static bool split_local_time(uint64_t date, struct tm *time) {
+    time_t seconds = (time_t)date;
+    if (localtime_r(&seconds, time) == NULL || time->tm_year + 1900 < 0 || time->tm_year + 1900 > 9999) {
+        memset(time, 0, sizeof(struct tm));
+        time->tm_year = -1900;
+        time->tm_mon = -1;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief           查找日期缓存[与写入并发时视为未命中]
+ * @param date      时间戳
+ * @param text      存放日期文本[DATE_TEXT_SIZE字节]
+ * @param seconds   存放本地当日已过秒数
+ * @return          false表示未命中，否则为命中
+ */
+static bool get_cached_date(uint64_t date, char *text, uint32_t *seconds) {
+    date_entry_t *entry = &s_date_cache[(date / seconds_per_day) % DATE_CACHE_SIZE];
+    uint64_t sequence = atomic_load_explicit(&entry->sequence, memory_order_acquire);
+    if (sequence & 1) {
+        return false;
+    }
+
+    uint64_t begin = atomic_load_explicit(&entry->begin, memory_order_relaxed);
+    uint64_t end = atomic_load_explicit(&entry->end, memory_order_relaxed);
+    uint64_t midnight = atomic_load_explicit(&entry->midnight, memory_order_relaxed);
+    uint64_t words[2] = {
+        atomic_load_explicit(&entry->text[0], memory_order_relaxed),
+        atomic_load_explicit(&entry->text[1], memory_order_relaxed),
+    };
+    atomic_thread_fence(memory_order_acquire);
+    if (atomic_load_explicit(&entry->sequence, memory_order_relaxed) != sequence || date < begin || date >= end) {
+        return false;
+    }
+    memcpy(text, words, DATE_TEXT_SIZE);
+    *seconds = (uint32_t)(date - midnight);
+    return true;
+}
+
+/**
+ * @brief           写入日期缓存[缓存时间戳所在本地日期与UTC日的交集，其他线程正在写入同一项时放弃]
+ * @param date      时间戳
+ * @param time      已拆分时间
+ * @param text      日期文本
+ */
+static void put_cached_date(uint64_t date, const struct tm *time, const char *text) {
+    uint64_t seconds = time->tm_hour * 3600 + time->tm_min * 60 + time->tm_sec;
+    if (date < seconds) {
+        return;
+    }
+    uint64_t midnight = date - seconds;
+    uint64_t day = date / seconds_per_day * seconds_per_day;
+    uint64_t begin = midnight > day ? midnight : day;
+    uint64_t end = midnight + seconds_per_day < day + seconds_per_day ? midnight + seconds_per_day : day + seconds_per_day;
+
+    // 区间内时区偏移变化[夏令时切换]时仅缓存该时间戳
+    struct tm first, last;
+    time_t first_time = (time_t)begin;
+    time_t last_time = (time_t)(end - 1);
+    if (localtime_r(&first_time, &first) == NULL || localtime_r(&last_time, &last) == NULL ||
+        first.tm_gmtoff != time->tm_gmtoff || last.tm_gmtoff != time->tm_gmtoff) {
+        begin = date;
+        end = date + 1;
+    }
+
+    uint64_t words[2] = {0};
+    memcpy(words, text, DATE_TEXT_SIZE);
+    date_entry_t *entry = &s_date_cache[(date / seconds_per_day) % DATE_CACHE_SIZE];
+    uint64_t sequence = atomic_load_explicit(&entry->sequence, memory_order_relaxed);
+    if ((sequence & 1) || !atomic_compare_exchange_strong_explicit(&entry->sequence, &sequence, sequence + 1,
+        memory_order_relaxed, memory_order_relaxed)) {
+        return;
+    }
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&entry->begin, begin, memory_order_relaxed);
+    atomic_store_explicit(&entry->end, end, memory_order_relaxed);
+    atomic_store_explicit(&entry->midnight, midnight, memory_order_relaxed);
+    atomic_store_explicit(&entry->text[0], words[0], memory_order_relaxed);
+    atomic_store_explicit(&entry->text[1], words[1], memory_order_relaxed);
+    atomic_store_explicit(&entry->sequence, sequence + 2, memory_order_release);
+}
+
+/**
+ * @brief           写入本地日期文本并获取当日已过秒数[优先使用日期缓存，未命中时按本地时区转换后缓存]
+ * @param buffer    写入位置[DATE_TEXT_SIZE字节]
+ * @param date      时间戳
+ * @return          本地当日已过秒数
+ */
+static uint32_t write_local_date(char *buffer, uint64_t date) {
+    uint32_t seconds = 0;
+    if (get_cached_date(date, buffer, &seconds)) {
+        return seconds;
+    }
+
+    struct tm time;
+    bool is_valid = split_local_time(date, &time);
+    write_date(buffer, &time);
+    if (is_valid) {
+        put_cached_date(date, &time, buffer);
+    }
+    return time.tm_hour * 3600 + time.tm_min * 60 + time.tm_sec;
+}
+
+/**
+ * @brief           格式化日期[本地时区，YYYY-MM-DD，不写入结尾'\0'，线程安全]
+ * @param buffer    写入位置[不少于DATE_TEXT_SIZE字节]
+ * @param date      时间戳
+ * @return          写入长度
+ */
+size_t format_date(char *buffer, uint64_t date) {
+    write_local_date(buffer, date);
+    return DATE_TEXT_SIZE;
+}
+
+/**
+ * @brief           格式化日期时间[本地时区，YYYY-MM-DD HH:MM:SS，不写入结尾'\0'，线程安全]
+ * @param buffer    写入位置[不少于DATE_TIME_TEXT_SIZE字节]
+ * @param date      时间戳
+ * @return          写入长度
+ */
+size_t format_date_time(char *buffer, uint64_t date) {
+    uint32_t seconds = write_local_date(buffer, date);
+    buffer[10] = ' ';
+    write_two_digits(buffer + 11, seconds / 3600);
+    buffer[13] = ':';
+    write_two_digits(buffer + 14, seconds / 60 % 60);
+    buffer[16] = ':';
+    write_two_digits(buffer + 17, seconds % 60);
+    return DATE_TIME_TEXT_SIZE;
+}
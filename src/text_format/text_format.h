@@ -0,0 +1,24 @@
+//
+//  text_format.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef text_format_h
+#define text_format_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define UINT64_TEXT_SIZE    20  // 64位无符号整数最大十进制位数
+#define DATE_TEXT_SIZE      10  // 日期文本长度[YYYY-MM-DD]
+#define DATE_TIME_TEXT_SIZE 19  // 日期时间文本长度[YYYY-MM-DD HH:MM:SS]
+
+size_t format_uint64(char *buffer, uint64_t number);
+size_t format_date(char *buffer, uint64_t date);
+size_t format_date_time(char *buffer, uint64_t date);
+
+#endif /* text_format_h */
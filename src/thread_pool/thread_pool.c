@@ -0,0 +1,257 @@
+//
+//  thread_pool.c
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#include "thread_pool.h"
+#include "common.h"
+#include "log.h"
+#include "mem_stat.h"
+#include <pthread.h>
+
+/**
+ * @brief 任务组[等待一批任务全部完成]
+ */
+typedef struct {
+    pthread_mutex_t lock;   // 任务组锁
+    pthread_cond_t done;    // 完成条件
+    uint32_t pending;       // 未完成任务数量
+} task_group_t;
+
+/**
+ * @brief 线程任务
+ */
+typedef struct {
+    thread_task_func_t func;    // 任务函数
+    void *arg;                  // 任务参数
+    task_group_t *group;        // 所属任务组[可选]
+} thread_task_t;
+
+/**
+ * @brief 线程池
+ */
+struct thread_pool {
+    pthread_mutex_t lock;       // 队列锁
+    pthread_cond_t not_empty;   // 队列非空条件
+    pthread_cond_t not_full;    // 队列未满条件
+    thread_task_t *tasks;       // 任务环形队列
+    uint32_t queue_size;        // 队列容量
+    uint32_t head;              // 队首位置
+    uint32_t count;             // 队列任务数量
+    bool is_stopped;            // 停止标志
+    uint32_t thread_count;      // 线程数量
+    pthread_t *threads;         // 工作线程
+};
+
+/**
+ * @brief           完成任务组中的一项任务
+ * @param group     任务组
+ */
+static void finish_group_task(task_group_t *group) {
+    pthread_mutex_lock(&group->lock);
+    if (--group->pending == 0) {
+        pthread_cond_signal(&group->done);
+    }
+    pthread_mutex_unlock(&group->lock);
+}
+
+/**
+ * @brief       工作线程循环任务
+ * @param arg   线程池
+ * @return      NULL
+ */
+static void *worker_loop(void *arg) {
+    thread_pool_t *pool = (thread_pool_t *)arg;
+
+    while (true) {
+        pthread_mutex_lock(&pool->lock);
+        while (pool->count == 0 && !pool->is_stopped) {
+            pthread_cond_wait(&pool->not_empty, &pool->lock);
+        }
+        if (pool->count == 0 && pool->is_stopped) {
+            pthread_mutex_unlock(&pool->lock);
+            break;
+        }
+        thread_task_t task = pool->tasks[pool->head];
+        pool->head = (pool->head + 1) % pool->queue_size;
+        pool->count--;
+        pthread_cond_signal(&pool->not_full);
+        pthread_mutex_unlock(&pool->lock);
+
+        task.func(task.arg);
+        if (task.group != NULL) {
+            finish_group_task(task.group);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief               创建线程池
+ * @param thread_count  工作线程数量
+ * @param queue_size    任务队列容量
+ * @return              NULL表示失败，否则为成功
+ */
+thread_pool_t *create_thread_pool(uint32_t thread_count, uint32_t queue_size) {
+    if (thread_count == 0 || queue_size == 0) {
+        LOG_C(LOG_ERROR, "Failed to create thread pool for invalid param.")
+        return NULL;
+    }
+
+    thread_pool_t *pool = mem_calloc(MEM_OTHER, 1, sizeof(thread_pool_t));
+    if (pool == NULL) {
+        LOG_C(LOG_ERROR, "Failed to calloc resources for thread pool.")
+        return NULL;
+    }
+    pool->tasks = mem_calloc(MEM_OTHER, queue_size, sizeof(thread_task_t));
+    pool->threads = mem_calloc(MEM_OTHER, thread_count, sizeof(pthread_t));
+    if (pool->tasks == NULL || pool->threads == NULL) {
+        LOG_C(LOG_ERROR, "Failed to calloc resources for thread pool.")
+        MEM_FREE(MEM_OTHER, pool->tasks)
+        MEM_FREE(MEM_OTHER, pool->threads)
+        MEM_FREE(MEM_OTHER, pool)
+        return NULL;
+    }
+    pool->queue_size = queue_size;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->not_empty, NULL);
+    pthread_cond_init(&pool->not_full, NULL);
+
+    for (uint32_t i = 0; i < thread_count; i++) {
+        if (pthread_create(&pool->threads[i], NULL, worker_loop, pool) != 0) {
+            LOG_C(LOG_ERROR, "Failed to create worker thread [%u].", i)
+            break;
+        }
+        pool->thread_count++;
+    }
+    if (pool->thread_count == 0) {
+        delete_thread_pool(&pool);
+        return NULL;
+    }
+    LOG_C(LOG_DEBUG, "Create thread pool with [%u] threads successfully.", pool->thread_count)
+
+    return pool;
+}
+
+/**
+ * @brief       删除线程池[等待已提交任务执行完成]
+ * @param pool  线程池
+ */
+void delete_thread_pool(thread_pool_t **pool) {
+    if (pool == NULL || *pool == NULL) {
+        return;
+    }
+
+    thread_pool_t *thread_pool = *pool;
+    pthread_mutex_lock(&thread_pool->lock);
+    thread_pool->is_stopped = true;
+    pthread_cond_broadcast(&thread_pool->not_empty);
+    pthread_mutex_unlock(&thread_pool->lock);
+    for (uint32_t i = 0; i < thread_pool->thread_count; i++) {
+        pthread_join(thread_pool->threads[i], NULL);
+    }
+
+    pthread_mutex_destroy(&thread_pool->lock);
+    pthread_cond_destroy(&thread_pool->not_empty);
+    pthread_cond_destroy(&thread_pool->not_full);
+    MEM_FREE(MEM_OTHER, thread_pool->tasks)
+    MEM_FREE(MEM_OTHER, thread_pool->threads)
+    MEM_FREE(MEM_OTHER, thread_pool)
+    *pool = NULL;
+}
+
+/**
+ * @brief       提交任务至队列[队列满时阻塞等待]
+ * @param pool  线程池
+ * @param task  任务
+ * @return      false表示线程池已停止，否则为成功
+ */
+static bool push_thread_task(thread_pool_t *pool, thread_task_t *task) {
+    pthread_mutex_lock(&pool->lock);
+    while (pool->count == pool->queue_size && !pool->is_stopped) {
+        pthread_cond_wait(&pool->not_full, &pool->lock);
+    }
+    if (pool->is_stopped) {
+        pthread_mutex_unlock(&pool->lock);
+        return false;
+    }
+    pool->tasks[(pool->head + pool->count) % pool->queue_size] = *task;
+    pool->count++;
+    pthread_cond_signal(&pool->not_empty);
+    pthread_mutex_unlock(&pool->lock);
+    return true;
+}
+
+/**
+ * @brief       异步提交任务
+ * @param pool  线程池
+ * @param func  任务函数
+ * @param arg   任务参数
+ * @return      false表示失败，否则为成功
+ */
+bool submit_thread_task(thread_pool_t *pool, thread_task_func_t func, void *arg) {
+    if (pool == NULL || func == NULL) {
+        return false;
+    }
+
+    thread_task_t task = {
+        .func = func,
+        .arg = arg,
+        .group = NULL
+    };
+    return push_thread_task(pool, &task);
+}
+
+/**
+ * @brief           并行执行一批任务并等待全部完成[线程池不可用时在当前线程顺序执行]
+ * @param pool      线程池[可为NULL]
+ * @param func      任务函数
+ * @param args      任务参数数组
+ * @param arg_size  单个任务参数大小
+ * @param count     任务数量
+ */
+void run_thread_tasks(thread_pool_t *pool, thread_task_func_t func, void *args, size_t arg_size, uint32_t count) {
+    if (func == NULL || args == NULL) {
+        return;
+    }
+
+    task_group_t group = {
+        .lock = PTHREAD_MUTEX_INITIALIZER,
+        .done = PTHREAD_COND_INITIALIZER,
+        .pending = count
+    };
+    for (uint32_t i = 0; i < count; i++) {
+        thread_task_t task = {
+            .func = func,
+            .arg = (char *)args + i * arg_size,
+            .group = &group
+        };
+        // 仅一项任务或提交失败时直接执行
+        if (pool == NULL || count == 1 || !push_thread_task(pool, &task)) {
+            func(task.arg);
+            finish_group_task(&group);
+        }
+    }
+
+    pthread_mutex_lock(&group.lock);
+    while (group.pending > 0) {
+        pthread_cond_wait(&group.done, &group.lock);
+    }
+    pthread_mutex_unlock(&group.lock);
+    pthread_mutex_destroy(&group.lock);
+    pthread_cond_destroy(&group.done);
+}
+
+/**
+ * @brief       获取工作线程数量
+ * @param pool  线程池
+ * @return      工作线程数量
+ */
+uint32_t get_thread_count(thread_pool_t *pool) {
+    if (pool == NULL) {
+        return 0;
+    }
+    return pool->thread_count;
+}
@@ -0,0 +1,25 @@
+//
+//  thread_pool.h
+//  EmployeeManager
+//
+//  Created by agent on 2026/10/18.
+//
+
+#ifndef thread_pool_h
+#define thread_pool_h
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct thread_pool thread_pool_t;           // 线程池
+typedef void (*thread_task_func_t)(void *arg);      // 线程任务函数指针
+
+thread_pool_t *create_thread_pool(uint32_t thread_count, uint32_t queue_size);
+void delete_thread_pool(thread_pool_t **pool);
+bool submit_thread_task(thread_pool_t *pool, thread_task_func_t func, void *arg);
+void run_thread_tasks(thread_pool_t *pool, thread_task_func_t func, void *args, size_t arg_size, uint32_t count);
+uint32_t get_thread_count(thread_pool_t *pool);
+
+#endif /* thread_pool_h */
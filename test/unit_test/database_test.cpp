@@ -10,6 +10,9 @@ extern "C" {
 #endif
 
 #include "hash_table.h"
+#include "bloom_filter.h"
+#include "thread_pool.h"
+#include "name_index.h"
 #include "common.h"
 
 #ifdef __cplusplus
@@ -188,4 +191,200 @@ TEST_F(HashTableTest, GetItem) {
     // 主键不在表内
     EXPECT_TRUE(get_item_by_key(hash_table, 10086) == NULL);
     delete_hash_table(&hash_table);
-}
\ No newline at end of file
+}
+TEST_F(HashTableTest, ScanRange) {
+    hash_table_t *hash_table = NULL;
+    uint64_t max_size = s_init_config.max_size;
+    int **check_infos = NULL;
+    uint64_t count = 0;
+    uint64_t total = 0;
+    int sum = 0;
+
+    hash_table = create_hash_table(&s_init_config);
+    ASSERT_FALSE(hash_table == NULL);
+    for (int i = 1; i <= max_size * 16; i++) {
+        add_item_to_table(&hash_table, i, &i, true);
+    }
+    uint64_t buckets = get_bucket_count_from_table(hash_table);
+    ASSERT_GT(buckets, 2);
+
+    // 各区间结果拼接后与全表一致[区间预估容量不足时倍增]
+    for (uint64_t begin = 0; begin < buckets; begin += 3) {
+        check_infos = (int **)get_items_by_value_in_range(hash_table, NULL, begin, begin + 3, &count);
+        ASSERT_FALSE(check_infos == NULL);
+        for (uint64_t i = 0; i < count; i++) {
+            sum += *check_infos[i];
+        }
+        total += count;
+        MEM_FREE(MEM_RESULT, check_infos)
+    }
+    EXPECT_EQ(total, max_size * 16);
+    EXPECT_EQ(sum, (int)(max_size * 16 * (max_size * 16 + 1) / 2));
+
+    // 空区间与越界区间
+    check_infos = (int **)get_items_by_value_in_range(hash_table, NULL, 1, 1, &count);
+    EXPECT_FALSE(check_infos == NULL);
+    EXPECT_EQ(count, 0);
+    MEM_FREE(MEM_RESULT, check_infos)
+    check_infos = (int **)get_items_by_value_in_range(hash_table, NULL, buckets, buckets * 2, &count);
+    EXPECT_FALSE(check_infos == NULL);
+    EXPECT_EQ(count, 0);
+    MEM_FREE(MEM_RESULT, check_infos)
+
+    EXPECT_TRUE(get_items_by_value_in_range(NULL, NULL, 0, 1, &count) == NULL);
+    EXPECT_EQ(get_bucket_count_from_table(NULL), 0);
+    delete_hash_table(&hash_table);
+}
+
+static bool count_item(void *value, void *context) {
+    (*(uint64_t *)context)++;
+    return *(uint64_t *)context < 3;
+}
+
+TEST_F(HashTableTest, TraverseItem) {
+    hash_table_t *hash_table = NULL;
+    uint64_t max_size = s_init_config.max_size;
+    uint64_t count = 0;
+    int info = 1;
+
+    hash_table = create_hash_table(&s_init_config);
+    ASSERT_FALSE(hash_table == NULL);
+    for (int i = 1; i <= max_size; i++) {
+        add_item_to_table(&hash_table, i, &info, true);
+    }
+
+    // 回调返回false终止遍历
+    EXPECT_FALSE(traverse_items_from_table(hash_table, NULL, count_item, &count));
+    EXPECT_EQ(count, 3);
+    count = 0;
+    info = 2;
+    EXPECT_TRUE(traverse_items_from_table(hash_table, &info, count_item, &count));
+    EXPECT_EQ(count, 0);
+
+    // 非法参数
+    EXPECT_FALSE(traverse_items_from_table(NULL, NULL, count_item, &count));
+    EXPECT_FALSE(traverse_items_from_table(hash_table, NULL, NULL, &count));
+    delete_hash_table(&hash_table);
+}
+
+static void square_number(void *arg) {
+    uint64_t *number = (uint64_t *)arg;
+    *number = *number * *number;
+}
+
+TEST_F(HashTableTest, ThreadPool) {
+    thread_pool_t *pool = NULL;
+    uint64_t numbers[16] = {0};
+
+    EXPECT_TRUE(create_thread_pool(0, 4) == NULL);
+    pool = create_thread_pool(4, 2);
+    ASSERT_FALSE(pool == NULL);
+    EXPECT_EQ(get_thread_count(pool), 4);
+
+    // 任务数量超过队列容量时阻塞提交
+    for (uint64_t i = 0; i < 16; i++) {
+        numbers[i] = i;
+    }
+    run_thread_tasks(pool, square_number, numbers, sizeof(uint64_t), 16);
+    for (uint64_t i = 0; i < 16; i++) {
+        EXPECT_EQ(numbers[i], i * i);
+    }
+
+    // 线程池为空时顺序执行
+    run_thread_tasks(NULL, square_number, numbers, sizeof(uint64_t), 2);
+    EXPECT_EQ(numbers[1], 1);
+    delete_thread_pool(&pool);
+    EXPECT_TRUE(pool == NULL);
+}
+
+TEST_F(HashTableTest, EditDistance) {
+    EXPECT_EQ(get_edit_distance("Zhangsan", "Zhangsan"), 0);
+    EXPECT_EQ(get_edit_distance("Zhangsan", "Zhangsn"), 1);
+    EXPECT_EQ(get_edit_distance("Zhangsn", "Zhangsan"), 1);
+    EXPECT_EQ(get_edit_distance("kitten", "sitting"), 3);
+    EXPECT_EQ(get_edit_distance("", "abc"), 3);
+    EXPECT_EQ(get_edit_distance("abc", ""), 3);
+
+    // 超过64字符时退化为动态规划
+    std::string src(100, 'a');
+    std::string dst = src;
+    dst[10] = 'b';
+    dst.erase(50, 2);
+    EXPECT_EQ(get_edit_distance(src.c_str(), dst.c_str()), 3);
+    EXPECT_EQ(get_edit_distance(dst.c_str(), src.c_str()), 3);
+}
+
+TEST_F(HashTableTest, MemStat) {
+    mem_stat_t before = {0};
+    mem_stat_t after = {0};
+
+    get_mem_stat(MEM_OTHER, &before);
+    char *ptr = (char *)mem_calloc(MEM_OTHER, 1, 100);
+    ASSERT_FALSE(ptr == NULL);
+    get_mem_stat(MEM_OTHER, &after);
+    EXPECT_GE(after.current, before.current + 100);
+    EXPECT_EQ(after.blocks, before.blocks + 1);
+
+    ptr = (char *)mem_realloc(MEM_OTHER, ptr, 1000);
+    ASSERT_FALSE(ptr == NULL);
+    get_mem_stat(MEM_OTHER, &after);
+    EXPECT_GE(after.current, before.current + 1000);
+    EXPECT_GE(after.peak, after.current);
+    EXPECT_EQ(after.blocks, before.blocks + 1);
+
+    MEM_FREE(MEM_OTHER, ptr)
+    get_mem_stat(MEM_OTHER, &after);
+    EXPECT_EQ(after.current, before.current);
+    EXPECT_EQ(after.blocks, before.blocks);
+    EXPECT_TRUE(ptr == NULL);
+}
+
+TEST_F(HashTableTest, BloomFilter) {
+    bloom_filter_t *filter = create_bloom_filter(1000);
+    bloom_stat_t stat = {0};
+    ASSERT_FALSE(filter == NULL);
+
+    // 已添加的键不会被误判为不存在
+    for (uint64_t i = 1; i <= 1000; i++) {
+        add_key_to_bloom_filter(filter, i);
+    }
+    EXPECT_FALSE(is_bloom_filter_full(filter));
+    for (uint64_t i = 1; i <= 1000; i++) {
+        EXPECT_TRUE(is_key_maybe_in_bloom_filter(filter, i));
+    }
+
+    // 未添加的键误判率低于5%
+    uint64_t positives = 0;
+    for (uint64_t i = 1000001; i <= 1100000; i++) {
+        positives += is_key_maybe_in_bloom_filter(filter, i) ? 1 : 0;
+    }
+    EXPECT_LT(positives, 5000);
+    get_bloom_filter_stat(filter, &stat);
+    EXPECT_EQ(stat.items, 1000);
+    EXPECT_EQ(stat.lookups, 101000);
+    EXPECT_EQ(stat.negatives, 100000 - positives);
+
+    // 删除后其余键仍可命中，已删除的键多数判定为不存在
+    uint64_t removed = 0;
+    for (uint64_t i = 1; i <= 500; i++) {
+        remove_key_from_bloom_filter(filter, i);
+    }
+    for (uint64_t i = 1; i <= 1000; i++) {
+        bool is_maybe = is_key_maybe_in_bloom_filter(filter, i);
+        if (i > 500) {
+            EXPECT_TRUE(is_maybe);
+        }
+        removed += !is_maybe && i <= 500 ? 1 : 0;
+    }
+    EXPECT_GT(removed, 450);
+
+    mark_bloom_false_positive(filter);
+    EXPECT_TRUE(resize_bloom_filter(filter, 100000));
+    get_bloom_filter_stat(filter, &stat);
+    EXPECT_EQ(stat.items, 0);
+    EXPECT_GE(stat.blocks * 16, 100000);
+    EXPECT_EQ(stat.false_positives, 1);
+    EXPECT_FALSE(is_key_maybe_in_bloom_filter(filter, 1000));
+    delete_bloom_filter(&filter);
+    EXPECT_TRUE(filter == NULL);
+}
@@ -11,6 +11,17 @@ extern "C" {
 
 #include "command_execution.h"
 #include "database_manager.h"
+#include "query_cache.h"
+#include "staff_sort.h"
+#include "mem_stat.h"
+#include "replication.h"
+#include "request_queue.h"
+#include "thread_pool.h"
+#include "text_format.h"
+#include <sys/socket.h>
+
+extern bool radix_sort_staffs(staff_info_t **values, uint64_t count, const sort_order_t *order, thread_pool_t *pool, uint32_t parts);
+extern uint32_t encode_frame(repl_op_t op, uint64_t sequence, const staff_info_t *info, char *output);
 
 #ifdef __cplusplus
 };
@@ -87,19 +98,97 @@ TEST_F(CommandExecTest, Del) {
     EXPECT_EQ(strcmp(request.result, "All staffs are removed."), 0);
 }
 
+TEST_F(CommandExecTest, BulkDel) {
+    query_info_t query;
+    user_request_t request;
+    staff_info_t info = {
+        .staff_id = 10088,
+        .name = (char *)"ZhaoLiu",
+        .department = (char *)"ZTA",
+        .position = (char *)"QA"
+    };
+    struct tm tm_time = {0};
+    strptime((char *)"2022-06-23 09:00:00", "%Y-%m-%d %H:%M:%S", &tm_time);
+    info.date = mktime(&tm_time);
+    add_item_to_database(&info);
+
+    // 试运行仅统计数量
+    bzero(&query, sizeof(query_info_t));
+    query.command = CMD_DEL;
+    query.info.department = (char *)"CWPP";
+    query.is_dry_run = true;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "[2] staffs would be removed."), 0);
+    EXPECT_EQ(get_count_from_database(), 3);
+
+    // 按部门及日期区间删除，分组计数与工号过滤器同步维护
+    query.is_dry_run = false;
+    query.date_to = get_by_id_from_database(10087)->date;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "[1] staffs are removed."), 0);
+    EXPECT_TRUE(get_by_id_from_database(10087) == NULL);
+    EXPECT_FALSE(get_by_id_from_database(10086) == NULL);
+    uint64_t count = 0;
+    group_count_t **groups = get_group_counts_from_database(GROUP_DEPT, &count);
+    for (uint64_t i = 0; i < count; i++) {
+        if (strcmp(groups[i]->value, "CWPP") == 0) {
+            EXPECT_EQ(groups[i]->count, 1);
+        }
+    }
+    MEM_FREE(MEM_RESULT, groups)
+
+    // 无匹配时成功但数量为0
+    query.date_from = query.date_to;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(request.is_success);
+    EXPECT_EQ(strcmp(request.result, "[0] staffs are removed."), 0);
+
+    bzero(&query, sizeof(query_info_t));
+    query.command = CMD_DEL;
+    query.is_opt_all = true;
+    query.is_dry_run = true;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "[2] staffs would be removed."), 0);
+    query.is_opt_all = false;
+    query.info.staff_id = 10088;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "[1] staffs would be removed."), 0);
+    EXPECT_EQ(get_count_from_database(), 2);
+}
+
 TEST_F(CommandExecTest, Mod) {
     query_info_t query = {
         .command = CMD_MOD,
         .info = {
             .staff_id = 10086,
-            .name = (char *)"ZhangSan",
+            .name = mem_strndup(MEM_STRING, "ZhangSan", 8),
         },
     };
     user_request_t request;
+    uint64_t date = get_by_id_from_database(10086)->date;
 
+    // 新值长于原值时转移解析所得字符串，未指定的日期保持不变
     bzero(&request, sizeof(user_request_t));
     execute_input_command(&query, &request);
     EXPECT_EQ(strcmp(request.result, "Info of the staff [10086] is modified."), 0);
+    EXPECT_TRUE(query.info.name == NULL);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10086)->name, "ZhangSan"), 0);
+    EXPECT_EQ(get_by_id_from_database(10086)->date, date);
+
+    bzero(&request, sizeof(user_request_t));
+    query.info.name = mem_strndup(MEM_STRING, "ZhangSan", 8);
+    query.info.department = mem_strndup(MEM_STRING, "CWPP", 4);
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(request.is_success);
+    EXPECT_EQ(strcmp(request.result, "Info of the staff [10086] is unchanged."), 0);
+    EXPECT_TRUE(query.info.name != NULL);
+    MEM_FREE(MEM_STRING, query.info.name)
+    MEM_FREE(MEM_STRING, query.info.department)
 
     bzero(&request, sizeof(user_request_t));
     query.info.staff_id = 10089;
@@ -136,18 +225,1266 @@ TEST_F(CommandExecTest, Get) {
 
     bzero(&request, sizeof(user_request_t));
     query.is_opt_all = true;
-    query.sort_type = SORT_ID;
+    query.sort_order = {{SORT_ID}, {false}, 1};
     execute_input_command(&query, &request);
     EXPECT_EQ(strcmp(request.result, "staff id: 10086, name: Lisi, date: 2022-06-25 09:00:00, department: CWPP, position: (null).\nstaff id: 10087, name: WangWu, date: 2022-06-24 09:00:00, department: CWPP, position: (null).\n"), 0);
 
     bzero(&request, sizeof(user_request_t));
     query.info.staff_id = 0;
     query.info.department = (char *)"CWPP";
-    query.sort_type = SORT_DATE;
+    query.sort_order = {{SORT_DATE}, {false}, 1};
     execute_input_command(&query, &request);
     EXPECT_EQ(strcmp(request.result, "staff id: 10087, name: WangWu, date: 2022-06-24 09:00:00, department: CWPP, position: (null).\nstaff id: 10086, name: Lisi, date: 2022-06-25 09:00:00, department: CWPP, position: (null).\n"), 0);
 }
 
+TEST_F(CommandExecTest, MultiGet) {
+    query_info_t query;
+    user_request_t request;
+    staff_info_t info = {0};
+    uint64_t ids[64] = {0};
+
+    // 数量超过预取距离，覆盖流水线预取
+    for (uint64_t i = 0; i < 64; i++) {
+        ids[i] = i % 2 == 0 ? 20000 + i : 30000 + i;
+        info.staff_id = 20000 + i;
+        add_item_to_database(&info);
+    }
+    staff_info_t *items[64] = {NULL};
+    EXPECT_EQ(get_by_ids_from_database(ids, 64, items), 32);
+    for (uint64_t i = 0; i < 64; i++) {
+        EXPECT_EQ(items[i] != NULL, i % 2 == 0);
+    }
+
+    // 按请求顺序合并输出，并提示不存在的工号数量
+    uint64_t staff_ids[] = {10087, 10089, 10086};
+    bzero(&query, sizeof(query_info_t));
+    query.command = CMD_GET;
+    query.staff_ids = staff_ids;
+    query.id_count = 3;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(request.is_success);
+    char *first = strstr(request.result, "staff id: 10087");
+    char *second = strstr(request.result, "staff id: 10086");
+    EXPECT_TRUE(first != NULL && second != NULL && first < second);
+    EXPECT_FALSE(strstr(request.result, "[1] of [3] staffs are not found.") == NULL);
+
+    query.id_count = 1;
+    query.staff_ids = staff_ids + 1;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "No items are found."), 0);
+}
+
+TEST_F(CommandExecTest, LargeResult) {
+    query_info_t query;
+    user_request_t request;
+    staff_info_t info = {
+        .name = (char *)"Zhangsan",
+        .department = (char *)"ZTA",
+        .position = (char *)"engineer"
+    };
+    for (uint64_t i = 0; i < 1000; i++) {
+        info.staff_id = 20000 + i;
+        add_item_to_database(&info);
+    }
+
+    // 结果超出BUFSIZ时完整输出，不截断
+    bzero(&query, sizeof(query_info_t));
+    query.command = CMD_GET;
+    query.info.department = (char *)"ZTA";
+    query.sort_order = {{SORT_ID}, {false}, 1};
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    const char *result = get_request_result(&request);
+    size_t length = get_request_result_length(&request);
+    EXPECT_FALSE(request.output == NULL);
+    EXPECT_GT(length, BUFSIZ);
+    EXPECT_EQ(strlen(result), length);
+    EXPECT_FALSE(strstr(result, "staff id: 20000,") == NULL);
+    EXPECT_FALSE(strstr(result, "staff id: 20999,") == NULL);
+
+    // 缓存命中时同样输出完整结果
+    char *first = strdup(result);
+    clear_request_result(&request);
+    EXPECT_TRUE(request.output == NULL);
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(get_request_result(&request), first), 0);
+    clear_request_result(&request);
+    free(first);
+
+    // 小结果仍位于result
+    bzero(&request, sizeof(user_request_t));
+    append_request_result(&request, "%s", "staff");
+    append_request_result(&request, " [%d].", 1);
+    EXPECT_TRUE(request.output == NULL);
+    EXPECT_EQ(strcmp(get_request_result(&request), "staff [1]."), 0);
+
+    // 预留写入跨越BUFSIZ时转存，设置结果时清除已有结果
+    char *cursor = reserve_request_result(&request, BUFSIZ);
+    ASSERT_FALSE(cursor == NULL);
+    memset(cursor, 'x', BUFSIZ);
+    commit_request_result(&request, BUFSIZ);
+    EXPECT_FALSE(request.output == NULL);
+    EXPECT_EQ(get_request_result_length(&request), strlen("staff [1].") + BUFSIZ);
+    EXPECT_EQ(strlen(get_request_result(&request)), get_request_result_length(&request));
+    append_request_text(&request, "!", 1);
+    EXPECT_EQ(get_request_result(&request)[get_request_result_length(&request) - 1], '!');
+    set_request_result(&request, "[%llu] staffs.", 3ULL);
+    EXPECT_TRUE(request.output == NULL);
+    EXPECT_EQ(strcmp(get_request_result(&request), "[3] staffs."), 0);
+    EXPECT_EQ(get_request_result_length(&request), strlen("[3] staffs."));
+}
+
+TEST_F(CommandExecTest, TextFormat) {
+    char text[BUFSIZ] = {'\0'};
+    char expect[BUFSIZ] = {'\0'};
+    uint64_t numbers[] = {0, 7, 10, 99, 100, 10086, 1234567890123ULL, UINT64_MAX};
+    for (uint64_t number : numbers) {
+        size_t length = format_uint64(text, number);
+        text[length] = '\0';
+        snprintf(expect, BUFSIZ, "%llu", (unsigned long long)number);
+        EXPECT_STREQ(text, expect);
+    }
+
+    // 与strftime按本地时区输出一致[再次格式化时命中日期缓存]
+    time_t dates[] = {0, 1656118800, 1656032400, 946684799, 4102444800};
+    for (uint8_t round = 0; round < 2; round++) {
+        for (time_t date : dates) {
+            struct tm time;
+            localtime_r(&date, &time);
+            size_t length = format_date_time(text, date);
+            text[length] = '\0';
+            strftime(expect, BUFSIZ, "%Y-%m-%d %H:%M:%S", &time);
+            EXPECT_STREQ(text, expect);
+            EXPECT_EQ(length, DATE_TIME_TEXT_SIZE);
+            length = format_date(text, date);
+            text[length] = '\0';
+            strftime(expect, BUFSIZ, "%Y-%m-%d", &time);
+            EXPECT_STREQ(text, expect);
+        }
+    }
+    // 逐小时跨越夏令时切换日及跨日边界
+    time_t begins[] = {1647043200, 1667606400, 1648252800};
+    for (time_t begin : begins) {
+        for (uint8_t round = 0; round < 2; round++) {
+            for (time_t date = begin; date < begin + 3 * 86400; date += 1800) {
+                struct tm time;
+                localtime_r(&date, &time);
+                text[format_date_time(text, date)] = '\0';
+                strftime(expect, BUFSIZ, "%Y-%m-%d %H:%M:%S", &time);
+                ASSERT_STREQ(text, expect);
+            }
+        }
+    }
+}
+
+/**
+ * @brief       并发格式化日期并与strftime比较[线程任务]
+ * @param arg   起始时间戳
+ * @return      不一致数量
+ */
+static void *format_dates_concurrently(void *arg) {
+    uint64_t begin = *(uint64_t *)arg;
+    uintptr_t mismatches = 0;
+    char text[DATE_TIME_TEXT_SIZE + 1] = {'\0'};
+    char expect[DATE_TIME_TEXT_SIZE + 1] = {'\0'};
+    for (uint64_t i = 0; i < 20000; i++) {
+        time_t date = begin + (i * 7919) % 3000 * 86400 + i % 86400;
+        struct tm time;
+        localtime_r(&date, &time);
+        text[format_date_time(text, date)] = '\0';
+        strftime(expect, sizeof(expect), "%Y-%m-%d %H:%M:%S", &time);
+        mismatches += strcmp(text, expect) != 0;
+    }
+    return (void *)mismatches;
+}
+
+TEST_F(CommandExecTest, DateCache) {
+    pthread_t threads[4];
+    uint64_t begins[4] = {1600000000, 1600003600, 1600000000 + 86400 * 7, 1500000000};
+    for (uint8_t i = 0; i < 4; i++) {
+        ASSERT_EQ(pthread_create(&threads[i], NULL, format_dates_concurrently, &begins[i]), 0);
+    }
+    for (uint8_t i = 0; i < 4; i++) {
+        void *mismatches = NULL;
+        pthread_join(threads[i], &mismatches);
+        EXPECT_EQ((uintptr_t)mismatches, 0);
+    }
+}
+
+TEST_F(CommandExecTest, GetPage) {
+    query_info_t query = {
+        .command = CMD_GET,
+        .info = {0},
+        .is_opt_all = true,
+        .sort_order = {{SORT_DATE}, {false}, 1},
+        .limit = 1,
+    };
+    user_request_t request;
+
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "staff id: 10087, name: WangWu, date: 2022-06-24 09:00:00, department: CWPP, position: (null).\n"), 0);
+
+    bzero(&request, sizeof(user_request_t));
+    query.offset = 1;
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "staff id: 10086, name: Lisi, date: 2022-06-25 09:00:00, department: CWPP, position: (null).\n"), 0);
+
+    bzero(&request, sizeof(user_request_t));
+    query.offset = 2;
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "No items are found."), 0);
+
+    // 乱序插入后选择前K项
+    staff_info_t info = {0};
+    for (uint64_t i = 0; i < 100; i++) {
+        info.staff_id = (i * 37) % 100 + 1;
+        add_item_to_database(&info);
+    }
+    bzero(&request, sizeof(user_request_t));
+    query.sort_order = {{SORT_ID}, {false}, 1};
+    query.limit = 2;
+    query.offset = 3;
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strncmp(request.result, "staff id: 4,", strlen("staff id: 4,")), 0);
+    EXPECT_TRUE(strstr(request.result, "staff id: 5,") != NULL);
+    EXPECT_TRUE(strstr(request.result, "staff id: 6,") == NULL);
+}
+
+TEST_F(CommandExecTest, StaffSort) {
+    const uint64_t count = 5000;
+    staff_info_t *infos = (staff_info_t *)calloc(count, sizeof(staff_info_t));
+    staff_info_t **values = (staff_info_t **)calloc(count, sizeof(staff_info_t *));
+    ASSERT_FALSE(infos == NULL || values == NULL);
+
+    // 差值超出int范围时比较结果仍正确
+    infos[0].staff_id = 1;
+    infos[1].staff_id = 1UL << 40;
+    values[0] = &infos[0];
+    values[1] = &infos[1];
+    sort_order_t id_order = {{SORT_ID}, {false}, 1};
+    EXPECT_LT(compare_staffs(values[0], values[1], &id_order), 0);
+    EXPECT_GT(compare_staffs(values[1], values[0], &id_order), 0);
+    EXPECT_EQ(compare_staffs(values[0], values[0], &id_order), 0);
+
+    for (uint64_t i = 0; i < count; i++) {
+        infos[i].staff_id = (i * 7919) % count + ((i % 3) << 40);
+        infos[i].date = 1600000000 + (i * 104729) % 86400 * 86400;
+        values[i] = &infos[i];
+    }
+    sort_order_t orders[] = {{{SORT_ID}, {false}, 1}, {{SORT_DATE}, {false}, 1}};
+    for (uint8_t t = 0; t < 2; t++) {
+        // 串行、分段[线程池为空时分段在当前线程执行]及对外接口结果一致
+        for (uint32_t parts = 1; parts <= 4; parts += 3) {
+            EXPECT_TRUE(radix_sort_staffs(values, count, &orders[t], NULL, parts));
+            for (uint64_t i = 1; i < count; i++) {
+                ASSERT_LE(compare_staffs(values[i - 1], values[i], &orders[t]), 0);
+            }
+            for (uint64_t i = 0; i < count; i++) {
+                values[i] = &infos[(i * 31) % count];
+            }
+        }
+        sort_staffs(values, count, &orders[t]);
+        for (uint64_t i = 1; i < count; i++) {
+            ASSERT_LE(compare_staffs(values[i - 1], values[i], &orders[t]), 0);
+        }
+    }
+
+    // 所有键相同时跳过所有趟
+    for (uint64_t i = 0; i < count; i++) {
+        infos[i].date = 1600000000;
+        values[i] = &infos[count - 1 - i];
+    }
+    EXPECT_TRUE(radix_sort_staffs(values, count, &orders[1], NULL, 2));
+    EXPECT_EQ(values[0], &infos[count - 1]);
+    free(values);
+    free(infos);
+}
+
+TEST_F(CommandExecTest, MultiKeySort) {
+    const uint64_t count = 3000;
+    // 部门含超出8字节前缀且前缀相同的字符串，须按完整字段比较
+    char depts[][32] = {"ZTA", "Research-Beijing", "Research-Shanghai", "CWPP", "Research-Beijing-Lab"};
+    char names[][16] = {"Zhangsan", "Lisi", "Wangwu", "Zhaoliu"};
+    staff_info_t *infos = (staff_info_t *)calloc(count, sizeof(staff_info_t));
+    staff_info_t **values = (staff_info_t **)calloc(count, sizeof(staff_info_t *));
+    ASSERT_FALSE(infos == NULL || values == NULL);
+    for (uint64_t i = 0; i < count; i++) {
+        infos[i].staff_id = i + 1;
+        infos[i].date = 1600000000 + (i * 7919) % 50 * 86400;
+        infos[i].department = depts[(i * 31) % 5];
+        infos[i].name = names[(i * 17) % 4];
+        values[i] = &infos[i];
+    }
+
+    sort_order_t order = {{SORT_DEPT, SORT_DATE, SORT_NAME}, {false, true, false}, 3};
+    for (uint32_t parts = 1; parts <= 3; parts += 2) {
+        EXPECT_TRUE(radix_sort_staffs(values, count, &order, NULL, parts));
+        EXPECT_EQ(strcmp(values[0]->department, "CWPP"), 0);
+        EXPECT_EQ(strcmp(values[count - 1]->department, "ZTA"), 0);
+        for (uint64_t i = 1; i < count; i++) {
+            ASSERT_LE(compare_staffs(values[i - 1], values[i], &order), 0);
+            // 全部字段相同时保持原有顺序
+            if (compare_staffs(values[i - 1], values[i], &order) == 0 && parts == 1) {
+                ASSERT_LT(values[i - 1]->staff_id, values[i]->staff_id);
+            }
+        }
+        for (uint64_t i = 0; i < count; i++) {
+            values[i] = &infos[count - 1 - i];
+        }
+    }
+
+    // 少量员工直接插入排序，降序取反
+    order.is_desc[0] = true;
+    sort_staffs(values, 20, &order);
+    for (uint64_t i = 1; i < 20; i++) {
+        ASSERT_LE(compare_staffs(values[i - 1], values[i], &order), 0);
+        ASSERT_GE(strcmp(values[i - 1]->department, values[i]->department), 0);
+    }
+    free(values);
+    free(infos);
+}
+
+TEST_F(CommandExecTest, ShardScan) {
+    staff_info_t info = {0};
+    staff_info_t **items = NULL;
+    uint64_t count = 0;
+    uint64_t total = 1000;
+
+    // 重建为8分片数据库
+    delete_database();
+    set_database_shard_count(8);
+    ASSERT_TRUE(create_database());
+    set_database_shard_count(0);
+    for (uint64_t i = 0; i < total; i++) {
+        info.staff_id = (i * 7919) % total + 20000;
+        info.date = total - i;
+        add_item_to_database(&info);
+    }
+    EXPECT_EQ(get_count_from_database(), total);
+
+    // 各分片结果合并后排序整体有序
+    sort_order_t id_order = {{SORT_ID}, {false}, 1};
+    sort_order_t date_order = {{SORT_DATE}, {false}, 1};
+    items = get_by_info_from_database(NULL, &count);
+    ASSERT_FALSE(items == NULL);
+    sort_staffs(items, count, &id_order);
+    EXPECT_EQ(count, total);
+    for (uint64_t i = 1; i < count; i++) {
+        EXPECT_LT(items[i-1]->staff_id, items[i]->staff_id);
+    }
+    FREE(items)
+
+    items = get_by_info_from_database(NULL, &count);
+    sort_staffs(items, count, &date_order);
+    EXPECT_EQ(count, total);
+    for (uint64_t i = 1; i < count; i++) {
+        EXPECT_LE(items[i-1]->date, items[i]->date);
+    }
+    FREE(items)
+}
+
+TEST_F(CommandExecTest, IdFilter) {
+    bloom_stat_t before = {0};
+    bloom_stat_t after = {0};
+    staff_info_t info = {0};
+    ASSERT_TRUE(get_id_filter_stat(&before));
+
+    // 过滤器随员工数量扩容，不存在的工号由过滤器直接排除
+    for (uint64_t i = 1; i <= 5000; i++) {
+        info.staff_id = i;
+        EXPECT_TRUE(add_item_to_database(&info));
+    }
+    EXPECT_FALSE(add_item_to_database(&info));
+    get_id_filter_stat(&after);
+    EXPECT_EQ(after.items, 5002);
+    EXPECT_GT(after.blocks, before.blocks);
+    for (uint64_t i = 1; i <= 5000; i++) {
+        EXPECT_FALSE(get_by_id_from_database(i) == NULL);
+    }
+    for (uint64_t i = 100001; i <= 110000; i++) {
+        EXPECT_TRUE(get_by_id_from_database(i) == NULL);
+    }
+    EXPECT_FALSE(remove_item_from_database(100001));
+    get_id_filter_stat(&after);
+    EXPECT_GT(after.negatives, 9000);
+    EXPECT_LT(after.false_positives, 1000);
+
+    for (uint64_t i = 1; i <= 5000; i++) {
+        EXPECT_TRUE(remove_item_from_database(i));
+    }
+    get_id_filter_stat(&after);
+    EXPECT_EQ(after.items, 2);
+
+    query_info_t query = {
+        .command = CMD_STAT,
+    };
+    user_request_t request;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(strstr(request.result, "Id filter: blocks [") != NULL);
+}
+
+TEST_F(CommandExecTest, CompactRecord) {
+    staff_info_t info = {0};
+    staff_info_t *item = get_by_id_from_database(10086);
+    ASSERT_FALSE(item == NULL);
+    char *name = item->name;
+
+    // 字符串紧随信息存放于同一内存块
+    EXPECT_TRUE((char *)item < item->name && item->name < item->department);
+    EXPECT_EQ(item->position, (char *)NULL);
+
+    // 新值不长于原值时原地覆盖，否则存放于堆上，记录地址不变
+    info.staff_id = 10086;
+    info.name = (char *)"Li";
+    info.date = item->date;
+    modify_item_from_database(&info, false, NULL);
+    EXPECT_EQ(get_by_id_from_database(10086), item);
+    EXPECT_EQ(item->name, name);
+    EXPECT_EQ(strcmp(item->name, "Li"), 0);
+    EXPECT_EQ(strcmp(item->department, "CWPP"), 0);
+
+    info.name = (char *)"Zhangsanfeng";
+    info.position = (char *)"engineer";
+    modify_item_from_database(&info, false, NULL);
+    EXPECT_EQ(get_by_id_from_database(10086), item);
+    EXPECT_EQ(strcmp(item->name, "Zhangsanfeng"), 0);
+    EXPECT_EQ(strcmp(item->position, "engineer"), 0);
+    EXPECT_EQ(strcmp(item->department, "CWPP"), 0);
+
+    // 仅报告实际变更字段，无变更时数据版本不变
+    uint8_t changed = MODIFY_NONE;
+    uint64_t version = get_database_version();
+    EXPECT_TRUE(modify_item_from_database(&info, false, &changed));
+    EXPECT_EQ(changed, MODIFY_NONE);
+    EXPECT_EQ(get_database_version(), version);
+    info.name = NULL;
+    info.department = (char *)"ZTA";
+    info.date = item->date + 86400;
+    EXPECT_TRUE(modify_item_from_database(&info, false, &changed));
+    EXPECT_EQ(changed, MODIFY_DATE | MODIFY_DEPT);
+    EXPECT_EQ(strcmp(item->name, "Zhangsanfeng"), 0);
+    EXPECT_EQ(item->date, info.date);
+    EXPECT_TRUE(remove_item_from_database(10086));
+}
+
+TEST_F(CommandExecTest, NamePattern) {
+    staff_info_t info = {0};
+    staff_info_t pattern = {0};
+    staff_info_t **items = NULL;
+    uint64_t count = 0;
+
+    info.staff_id = 10088;
+    info.name = (char *)"Zhangsan";
+    add_item_to_database(&info);
+    info.staff_id = 10089;
+    info.name = (char *)"Zhaoliu";
+    add_item_to_database(&info);
+
+    // 前缀匹配
+    sort_order_t id_order = {{SORT_ID}, {false}, 1};
+    pattern.name = (char *)"Zha";
+    items = get_by_name_pattern_from_database(&pattern, NAME_PREFIX, 0, &count);
+    ASSERT_EQ(count, 2);
+    sort_staffs(items, count, &id_order);
+    EXPECT_EQ(items[0]->staff_id, 10088);
+    EXPECT_EQ(items[1]->staff_id, 10089);
+    FREE(items)
+    pattern.name = (char *)"Z";
+    items = get_by_name_pattern_from_database(&pattern, NAME_PREFIX, 0, &count);
+    EXPECT_EQ(count, 2);
+    FREE(items)
+    pattern.name = (char *)"ang";
+    items = get_by_name_pattern_from_database(&pattern, NAME_PREFIX, 0, &count);
+    EXPECT_EQ(count, 0);
+    FREE(items)
+
+    // 子串匹配[过短时退化为遍历]
+    items = get_by_name_pattern_from_database(&pattern, NAME_SUBSTR, 0, &count);
+    ASSERT_EQ(count, 2);
+    FREE(items)
+    pattern.name = (char *)"an";
+    items = get_by_name_pattern_from_database(&pattern, NAME_SUBSTR, 0, &count);
+    ASSERT_EQ(count, 2);
+    sort_staffs(items, count, &id_order);
+    EXPECT_EQ(items[0]->staff_id, 10087);
+    EXPECT_EQ(items[1]->staff_id, 10088);
+    FREE(items)
+
+    // 改名及删除后索引同步更新
+    info.staff_id = 10088;
+    info.name = (char *)"Lisan";
+    modify_item_from_database(&info, false, NULL);
+    remove_item_from_database(10087);
+    pattern.name = (char *)"ang";
+    items = get_by_name_pattern_from_database(&pattern, NAME_SUBSTR, 0, &count);
+    EXPECT_EQ(count, 0);
+    FREE(items)
+    pattern.name = (char *)"Lis";
+    items = get_by_name_pattern_from_database(&pattern, NAME_PREFIX, 0, &count);
+    EXPECT_EQ(count, 2);
+    FREE(items)
+
+    // 模糊匹配[Lisi与Lisan距离为2，Zhaoliu与Lisi距离较远]
+    pattern.name = (char *)"Lisy";
+    items = get_by_name_pattern_from_database(&pattern, NAME_FUZZY, 1, &count);
+    ASSERT_EQ(count, 1);
+    EXPECT_EQ(items[0]->staff_id, 10086);
+    FREE(items)
+    items = get_by_name_pattern_from_database(&pattern, NAME_FUZZY, 2, &count);
+    ASSERT_EQ(count, 2);
+    sort_staffs(items, count, &id_order);
+    EXPECT_EQ(items[1]->staff_id, 10088);
+    FREE(items)
+    pattern.name = (char *)"WangWu";
+    items = get_by_name_pattern_from_database(&pattern, NAME_FUZZY, 2, &count);
+    EXPECT_EQ(count, 0);
+    FREE(items)
+
+    query_info_t query = {
+        .command = CMD_GET,
+        .info = {0},
+        .name_match = NAME_PREFIX,
+        .sort_order = {{SORT_ID}, {false}, 1},
+        .limit = 1,
+    };
+    user_request_t request;
+    query.info.name = (char *)"Lis";
+    query.info.department = (char *)"CWPP";
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "staff id: 10086, name: Lisi, date: 2022-06-25 09:00:00, department: CWPP, position: (null).\n"), 0);
+}
+
+TEST_F(CommandExecTest, Export) {
+    char path[] = "/tmp/em_export_test";
+    query_info_t query = {
+        .command = CMD_EXPORT,
+        .info = {0},
+        .is_opt_all = true,
+        .sort_order = {{SORT_ID}, {false}, 1},
+    };
+    user_request_t request;
+    char content[BUFSIZ] = {'\0'};
+    FILE *file = NULL;
+
+    query.export_path = path;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(request.is_success);
+    EXPECT_EQ(strcmp(request.result, "Total [2] staffs are exported."), 0);
+    file = fopen(path, "r");
+    ASSERT_FALSE(file == NULL);
+    fread(content, 1, BUFSIZ - 1, file);
+    fclose(file);
+    EXPECT_EQ(strcmp(content, "staff_id,name,date,department,position\n"
+        "10086,Lisi,2022-06-25,CWPP,\n10087,WangWu,2022-06-24,CWPP,\n"), 0);
+
+    bzero(content, BUFSIZ);
+    bzero(&request, sizeof(user_request_t));
+    query.export_format = EXPORT_JSONL;
+    query.sort_order = {{SORT_DATE}, {false}, 1};
+    execute_input_command(&query, &request);
+    file = fopen(path, "r");
+    ASSERT_FALSE(file == NULL);
+    fread(content, 1, BUFSIZ - 1, file);
+    fclose(file);
+    EXPECT_EQ(strcmp(content,
+        "{\"staff_id\":10087,\"name\":\"WangWu\",\"date\":\"2022-06-24\",\"department\":\"CWPP\",\"position\":null}\n"
+        "{\"staff_id\":10086,\"name\":\"Lisi\",\"date\":\"2022-06-25\",\"department\":\"CWPP\",\"position\":null}\n"), 0);
+    unlink(path);
+
+    bzero(&request, sizeof(user_request_t));
+    query.export_path = (char *)"/nonexistent/em_export_test";
+    execute_input_command(&query, &request);
+    EXPECT_FALSE(request.is_success);
+
+    bzero(&request, sizeof(user_request_t));
+    query.export_path = path;
+    request.input_fd = 5;
+    execute_input_command(&query, &request);
+    EXPECT_FALSE(request.is_success);
+    EXPECT_EQ(strcmp(request.result, "Export to file is only allowed from local console."), 0);
+    EXPECT_NE(access(path, F_OK), 0);
+
+    // 请求方已断开时导出失败，不产生SIGPIPE
+    int fds[2] = {-1, -1};
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    close(fds[1]);
+    bzero(&request, sizeof(user_request_t));
+    query.export_path = NULL;
+    request.input_fd = fds[0];
+    execute_input_command(&query, &request);
+    EXPECT_FALSE(request.is_success);
+    close(fds[0]);
+}
+
+TEST_F(CommandExecTest, Count) {
+    query_info_t query = {
+        .command = CMD_COUNT,
+    };
+    query_info_t mod_query = {
+        .command = CMD_MOD,
+        .info = {
+            .staff_id = 10086,
+            .department = (char *)"ZTA",
+        },
+    };
+    user_request_t request;
+
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "Total [2] staffs."), 0);
+
+    bzero(&request, sizeof(user_request_t));
+    query.group_type = GROUP_YEAR;
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "[2022]: [2] staffs.\n"), 0);
+
+    bzero(&request, sizeof(user_request_t));
+    query.group_type = GROUP_POS;
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "[(null)]: [2] staffs.\n"), 0);
+
+    // 修改及删除后计数同步更新
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&mod_query, &request);
+    bzero(&request, sizeof(user_request_t));
+    query.group_type = GROUP_DEPT;
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "[CWPP]: [1] staffs.\n[ZTA]: [1] staffs.\n"), 0);
+
+    remove_item_from_database(10087);
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "[ZTA]: [1] staffs.\n"), 0);
+}
+
+TEST_F(CommandExecTest, QueryCache) {
+    query_info_t query = {
+        .command = CMD_GET,
+        .info = {0},
+        .is_opt_all = true,
+        .sort_order = {{SORT_ID}, {false}, 1},
+    };
+    query_info_t add_query = {
+        .command = CMD_ADD,
+        .info = {
+            .staff_id = 10088,
+            .name = (char *)"ZhangSan",
+        },
+    };
+    user_request_t request;
+    user_request_t cached_request;
+    query_cache_stat_t before = {0};
+    query_cache_stat_t after = {0};
+
+    get_query_cache_stat(&before);
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    bzero(&cached_request, sizeof(user_request_t));
+    execute_input_command(&query, &cached_request);
+    get_query_cache_stat(&after);
+    EXPECT_EQ(strcmp(request.result, cached_request.result), 0);
+    EXPECT_EQ(after.hits, before.hits + 1);
+
+    // 数据变更后缓存失效
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&add_query, &request);
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    get_query_cache_stat(&before);
+    EXPECT_EQ(before.hits, after.hits);
+    EXPECT_EQ(before.invalidations, after.invalidations + 1);
+    EXPECT_NE(strcmp(request.result, cached_request.result), 0);
+
+    // 超长结果不缓存
+    char *large_result = (char *)malloc(CACHE_RESULT_SIZE + 2);
+    ASSERT_FALSE(large_result == NULL);
+    memset(large_result, 'x', CACHE_RESULT_SIZE + 1);
+    large_result[CACHE_RESULT_SIZE + 1] = '\0';
+    query.limit = 1;
+    get_query_cache_stat(&before);
+    put_query_cache(&query, large_result);
+    bzero(&request, sizeof(user_request_t));
+    EXPECT_FALSE(get_query_cache(&query, &request));
+    get_query_cache_stat(&after);
+    EXPECT_EQ(after.entries, before.entries);
+    large_result[CACHE_RESULT_SIZE] = '\0';
+    put_query_cache(&query, large_result);
+    EXPECT_TRUE(get_query_cache(&query, &request));
+    EXPECT_EQ(strlen(get_request_result(&request)), CACHE_RESULT_SIZE);
+    free(large_result);
+    clear_request_result(&request);
+    query.limit = 0;
+
+    query.command = CMD_STAT;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(request.is_success);
+}
+
+TEST_F(CommandExecTest, RecordCache) {
+    query_info_t query = {
+        .command = CMD_GET,
+        .info = {
+            .staff_id = 10086,
+        },
+    };
+    user_request_t request;
+    user_request_t cached_request;
+    query_cache_stat_t before = {0};
+    query_cache_stat_t after = {0};
+
+    // 重复查询同一工号命中渲染结果
+    get_record_cache_stat(&before);
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    bzero(&cached_request, sizeof(user_request_t));
+    execute_input_command(&query, &cached_request);
+    get_record_cache_stat(&after);
+    EXPECT_EQ(strcmp(request.result, cached_request.result), 0);
+    EXPECT_EQ(after.hits, before.hits + 1);
+    EXPECT_EQ(after.entries, before.entries + 1);
+
+    // 修改、删除后缓存失效
+    staff_info_t info = {
+        .staff_id = 10086,
+        .name = (char *)"Zhangsan",
+    };
+    modify_item_from_database(&info, false, NULL);
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(strstr(request.result, "name: Zhangsan,") != NULL);
+    remove_item_from_database(10086);
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "Staff with id [10086] is not found."), 0);
+    get_record_cache_stat(&before);
+    EXPECT_EQ(before.invalidations, after.invalidations + 2);
+    EXPECT_EQ(before.entries, after.entries - 1);
+
+    // 超过容量后按CLOCK淘汰
+    for (uint64_t i = 1; i <= before.capacity * 2; i++) {
+        info.staff_id = i;
+        add_item_to_database(&info);
+        query.info.staff_id = i;
+        execute_input_command(&query, &request);
+    }
+    get_record_cache_stat(&after);
+    EXPECT_GT(after.evictions, before.evictions);
+    EXPECT_LE(after.entries, after.capacity);
+    delete_database();
+    create_database();
+    get_record_cache_stat(&after);
+    EXPECT_EQ(after.entries, 0);
+}
+
+TEST_F(CommandExecTest, Batch) {
+    query_info_t query = {
+        .command = CMD_BEGIN,
+    };
+    user_request_t request;
+
+    // 入队指令在提交前不生效，提交后一并生效
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(request.is_success);
+    execute_input_command(&query, &request);
+    EXPECT_FALSE(request.is_success);
+    for (uint64_t id = 10086; id <= 10087; id++) {
+        query.command = CMD_MOD;
+        query.info.staff_id = id;
+        query.info.department = mem_strndup(MEM_STRING, "ZTA", 3);
+        execute_input_command(&query, &request);
+        EXPECT_TRUE(request.is_success);
+        EXPECT_TRUE(query.info.department == NULL);
+    }
+    EXPECT_EQ(strcmp(request.result, "Command [2] is queued."), 0);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10086)->department, "CWPP"), 0);
+    query.command = CMD_COMMIT;
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "Batch of [2] commands is committed."), 0);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10086)->department, "ZTA"), 0);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10087)->department, "ZTA"), 0);
+
+    // 任一指令失败则撤销已执行指令
+    query.command = CMD_BEGIN;
+    execute_input_command(&query, &request);
+    query.command = CMD_ADD;
+    query.info.staff_id = 10090;
+    query.info.name = mem_strndup(MEM_STRING, "Zhaoliu", 7);
+    execute_input_command(&query, &request);
+    query.command = CMD_MOD;
+    query.info.staff_id = 10086;
+    query.info.name = mem_strndup(MEM_STRING, "Zhangsan", 8);
+    execute_input_command(&query, &request);
+    query.command = CMD_DEL;
+    query.info.staff_id = 10086;
+    execute_input_command(&query, &request);
+    query.command = CMD_DEL;
+    query.info.staff_id = 10099;
+    execute_input_command(&query, &request);
+    query.command = CMD_COMMIT;
+    execute_input_command(&query, &request);
+    EXPECT_FALSE(request.is_success);
+    EXPECT_TRUE(strstr(request.result, "Batch is rolled back at command [4].") != NULL);
+    EXPECT_TRUE(get_by_id_from_database(10090) == NULL);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10086)->name, "Lisi"), 0);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10086)->department, "ZTA"), 0);
+    EXPECT_EQ(get_count_from_database(), 2);
+
+    // 批内存在无效指令则整体放弃
+    query.command = CMD_BEGIN;
+    execute_input_command(&query, &request);
+    query.command = CMD_DEL;
+    query.is_opt_all = true;
+    execute_input_command(&query, &request);
+    EXPECT_FALSE(request.is_success);
+    query.command = CMD_COMMIT;
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "Batch is aborted for invalid commands, nothing is changed."), 0);
+    EXPECT_EQ(get_count_from_database(), 2);
+
+    query.command = CMD_BEGIN;
+    query.is_opt_all = false;
+    execute_input_command(&query, &request);
+    fail_command_batch(request.input_fd);
+    query.command = CMD_ROLLBACK;
+    execute_input_command(&query, &request);
+    EXPECT_EQ(strcmp(request.result, "Batch is discarded, nothing is changed."), 0);
+    query.command = CMD_COMMIT;
+    execute_input_command(&query, &request);
+    EXPECT_FALSE(request.is_success);
+}
+
+/**
+ * @brief       获取共享执行权后立即释放[线程任务]
+ * @param arg   未使用
+ * @return      NULL
+ */
+static void *acquire_shared_gate(void *arg) {
+    acquire_command_gate(GATE_SHARED);
+    release_command_gate();
+    return NULL;
+}
+
+TEST_F(CommandExecTest, Gate) {
+    gate_stat_t before = {0};
+    gate_stat_t after = {0};
+
+    // 共享执行权可同时持有，不产生等待
+    get_command_gate_stat(GATE_SHARED, &before);
+    acquire_command_gate(GATE_SHARED);
+    acquire_command_gate(GATE_SHARED);
+    release_command_gate();
+    release_command_gate();
+    get_command_gate_stat(GATE_SHARED, &after);
+    EXPECT_EQ(after.acquisitions, before.acquisitions + 2);
+    EXPECT_EQ(after.contentions, before.contentions);
+
+    // 独占执行权阻塞共享获取，释放后计入等待
+    pthread_t thread;
+    acquire_command_gate(GATE_EXCLUSIVE);
+    ASSERT_EQ(pthread_create(&thread, NULL, acquire_shared_gate, NULL), 0);
+    usleep(20000);
+    release_command_gate();
+    pthread_join(thread, NULL);
+    get_command_gate_stat(GATE_SHARED, &before);
+    EXPECT_EQ(before.acquisitions, after.acquisitions + 1);
+    EXPECT_EQ(before.contentions, after.contentions + 1);
+    EXPECT_GE(before.max_wait_us, 10000);
+    EXPECT_GE(before.wait_us, before.max_wait_us);
+
+    query_info_t query = {
+        .command = CMD_STAT,
+    };
+    user_request_t request;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(strstr(request.result, "Gate [shared]: acquisitions [") != NULL);
+    EXPECT_TRUE(strstr(request.result, "Gate [exclusive]: acquisitions [") != NULL);
+}
+
+static request_job_t *s_done_jobs[8] = {NULL};  // 已完成请求任务
+static uint8_t s_done_count = 0;                // 已完成请求数量
+
+/**
+ * @brief       记录已完成请求任务[请求队列完成回调]
+ * @param job   请求任务
+ */
+static void collect_done_job(request_job_t *job) {
+    s_done_jobs[s_done_count++] = job;
+}
+
+TEST_F(CommandExecTest, RequestQueue) {
+    request_queue_stat_t stat = {0};
+    fd_set fds;
+
+    EXPECT_FALSE(submit_request_job(NULL));
+    EXPECT_FALSE(init_request_queue(0, 4, collect_done_job));
+    ASSERT_TRUE(init_request_queue(2, 4, collect_done_job));
+    EXPECT_FALSE(init_request_queue(2, 4, collect_done_job));
+
+    // 工作线程执行，结果经通知描述符交回
+    s_done_count = 0;
+    for (uint8_t i = 0; i < 6; i++) {
+        request_job_t *job = create_request_job(i + 1);
+        ASSERT_FALSE(job == NULL);
+        job->query.command = CMD_GET;
+        job->query.info.staff_id = i % 3 == 2 ? 0 : (i % 2 == 0 ? 10086 : 1);
+        job->query.is_opt_all = job->query.info.staff_id == 0;
+        job->query.priority = classify_query_priority(&job->query);
+        EXPECT_TRUE(submit_request_job(job));
+    }
+    while (s_done_count < 6) {
+        FD_ZERO(&fds);
+        int max_fd = set_request_queue_fds(&fds, -1);
+        ASSERT_GE(max_fd, 0);
+        ASSERT_GT(select(max_fd + 1, &fds, NULL, NULL, NULL), 0);
+        process_request_queue_fds(&fds);
+    }
+    for (uint8_t i = 0; i < s_done_count; i++) {
+        request_job_t *job = s_done_jobs[i];
+        const char *expect = job->query.info.staff_id != 1 ? "10086" : "Staff with id [1] is not found.";
+        EXPECT_EQ(job->query.priority, job->query.is_opt_all ? PRIORITY_LOW : PRIORITY_HIGH);
+        EXPECT_TRUE(strstr(get_request_result(&job->request), expect) != NULL);
+        delete_request_job(&job);
+        EXPECT_TRUE(job == NULL);
+    }
+
+    // 高低优先级请求分别排队
+    get_request_queue_stat(PRIORITY_HIGH, &stat);
+    EXPECT_EQ(stat.workers, 2);
+    EXPECT_EQ(stat.capacity, 4);
+    EXPECT_EQ(stat.depth, 0);
+    EXPECT_GE(stat.completed, 4);
+    EXPECT_GE(stat.max_depth, 1);
+    EXPECT_GE(stat.exec_us, stat.max_exec_us);
+    get_request_queue_stat(PRIORITY_LOW, &stat);
+    EXPECT_EQ(stat.workers, 1);
+    EXPECT_EQ(stat.depth, 0);
+    EXPECT_GE(stat.completed, 2);
+
+    query_info_t query = {
+        .command = CMD_STAT,
+    };
+    user_request_t request;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(strstr(request.result, "Request queue [high]: workers [2], depth [0/4]") != NULL);
+    EXPECT_TRUE(strstr(request.result, "Request queue [low]: workers [1], depth [0/4]") != NULL);
+
+    // 释放时交回未处理的完成请求
+    s_done_count = 0;
+    request_job_t *job = create_request_job(1);
+    job->query.command = CMD_COUNT;
+    EXPECT_TRUE(submit_request_job(job));
+    uninit_request_queue();
+    EXPECT_EQ(s_done_count, 1);
+    delete_request_job(&s_done_jobs[0]);
+    EXPECT_FALSE(submit_request_job(s_done_jobs[0]));
+    get_request_queue_stat(PRIORITY_HIGH, &stat);
+    EXPECT_EQ(stat.workers, 0);
+
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(strstr(request.result, "Request queue [high]: off.") != NULL);
+}
+
+/**
+ * @brief       扫描获取执行权后新增员工[线程任务]
+ * @param arg   扫描开始前的共享执行权获取次数
+ * @return      NULL
+ */
+static void *add_during_scan(void *arg) {
+    gate_stat_t stat = {0};
+    do {
+        get_command_gate_stat(GATE_SHARED, &stat);
+    } while (stat.acquisitions == *(uint64_t *)arg);
+
+    query_info_t query = {
+        .command = CMD_ADD,
+        .info = {
+            .staff_id = 1,
+            .name = (char *)"Zhaoliu",
+        },
+    };
+    user_request_t request;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    return NULL;
+}
+
+TEST_F(CommandExecTest, ScanSlice) {
+    staff_info_t info = {0};
+    info.name = (char *)"Zhangsan";
+    info.department = (char *)"ZTA";
+    for (uint64_t i = 100000; i < 200000; i++) {
+        info.staff_id = i;
+        add_item_to_database(&info);
+    }
+    uint64_t total = get_count_from_database();
+
+    // 低优先级全量查询分时间片执行，期间新增员工时结果不混杂新旧数据
+    query_info_t query = {
+        .command = CMD_GET,
+        .is_opt_all = true,
+    };
+    query.priority = classify_query_priority(&query);
+    EXPECT_EQ(query.priority, PRIORITY_LOW);
+    user_request_t request;
+    bzero(&request, sizeof(user_request_t));
+    gate_stat_t before = {0};
+    get_command_gate_stat(GATE_SHARED, &before);
+    pthread_t thread;
+    ASSERT_EQ(pthread_create(&thread, NULL, add_during_scan, &before.acquisitions), 0);
+    execute_input_command(&query, &request);
+    pthread_join(thread, NULL);
+
+    uint64_t lines = 0;
+    const char *result = get_request_result(&request);
+    for (const char *line = strstr(result, "staff id: "); line != NULL; line = strstr(line + 1, "staff id: ")) {
+        lines++;
+    }
+    bool has_new = strstr(result, "staff id: 1, ") != NULL;
+    EXPECT_EQ(lines, total + (has_new ? 1 : 0));
+    EXPECT_EQ(get_count_from_database(), total + 1);
+    clear_request_result(&request);
+
+    // 低优先级姓名前缀查询同样经分片遍历收集
+    query_info_t prefix = {
+        .command = CMD_GET,
+        .info = {
+            .name = (char *)"Zhang",
+        },
+        .name_match = NAME_PREFIX,
+    };
+    prefix.priority = classify_query_priority(&prefix);
+    EXPECT_EQ(prefix.priority, PRIORITY_LOW);
+
+    // 少量工号查询为高优先级，大量工号查询为低优先级
+    query_info_t ids = {
+        .command = CMD_GET,
+        .id_count = 64,
+    };
+    EXPECT_EQ(classify_query_priority(&ids), PRIORITY_HIGH);
+    ids.id_count = 65;
+    EXPECT_EQ(classify_query_priority(&ids), PRIORITY_LOW);
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&prefix, &request);
+    lines = 0;
+    result = get_request_result(&request);
+    for (const char *line = strstr(result, "staff id: "); line != NULL; line = strstr(line + 1, "staff id: ")) {
+        lines++;
+    }
+    EXPECT_EQ(lines, 100000u);
+    EXPECT_TRUE(strstr(result, "Zhaoliu") == NULL);
+    clear_request_result(&request);
+
+    query_info_t stat = {
+        .command = CMD_STAT,
+    };
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&stat, &request);
+    EXPECT_TRUE(strstr(request.result, "Scan slices: yields [") != NULL);
+    clear_request_result(&request);
+}
+
+TEST_F(CommandExecTest, Mem) {
+    mem_stat_t before = {0};
+    mem_stat_t after = {0};
+    staff_info_t info = {0};
+
+    // 增删员工后记录内存恢复原值
+    get_mem_stat(MEM_RECORD, &before);
+    info.name = (char *)"Zhangsan";
+    info.department = (char *)"ZTA";
+    for (uint64_t i = 1; i <= 100; i++) {
+        info.staff_id = i;
+        add_item_to_database(&info);
+    }
+    get_mem_stat(MEM_RECORD, &after);
+    EXPECT_EQ(after.blocks, before.blocks + 100);
+    EXPECT_GE(after.current, before.current + 100 * (sizeof(staff_info_t) + strlen("Zhangsan") + strlen("ZTA") + 2));
+    EXPECT_GE(after.peak, after.current);
+    for (uint64_t i = 1; i <= 100; i++) {
+        remove_item_from_database(i);
+    }
+    get_mem_stat(MEM_RECORD, &after);
+    EXPECT_EQ(after.current, before.current);
+    EXPECT_EQ(after.blocks, before.blocks);
+
+    query_info_t query = {
+        .command = CMD_MEM,
+    };
+    user_request_t request;
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(request.is_success);
+    EXPECT_TRUE(strstr(request.result, "[record]: current [") != NULL);
+    EXPECT_TRUE(strstr(request.result, "[total]: current [") != NULL);
+    EXPECT_TRUE(strstr(request.result, "Total [2] staffs, ") != NULL);
+}
+
+TEST_F(CommandExecTest, Replication) {
+    int fds[2] = {-1, -1};
+    repl_stat_t stat;
+    query_info_t query = {
+        .command = CMD_ADD,
+        .info = {
+            .staff_id = 10088,
+            .name = (char *)"ZhangSan",
+            .department = (char *)"ZTA",
+        },
+    };
+    user_request_t request;
+    bzero(&stat, sizeof(repl_stat_t));
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+    // 新跟随者先接收快照，再接收增量变更
+    ASSERT_TRUE(init_replication(REPL_PRIMARY, 0));
+    EXPECT_TRUE(add_replication_follower(fds[0]));
+    delete_database();
+    create_database();
+    EXPECT_TRUE(apply_replication_stream(fds[1]));
+    EXPECT_EQ(get_count_from_database(), 2);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10087)->name, "WangWu"), 0);
+
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(request.is_success);
+    query.command = CMD_MOD;
+    query.info.name = (char *)"Zhangsan";
+    query.info.department = NULL;
+    execute_input_command(&query, &request);
+    query.command = CMD_DEL;
+    query.info.staff_id = 10086;
+    execute_input_command(&query, &request);
+    get_replication_stat(&stat);
+    EXPECT_EQ(stat.sequence, 3);
+    EXPECT_EQ(stat.followers, 1);
+
+    // 回滚本地数据后应用增量，结果与主节点一致
+    remove_item_from_database(10088);
+    staff_info_t info = {
+        .staff_id = 10086,
+        .name = (char *)"Lisi",
+    };
+    add_item_to_database(&info);
+    EXPECT_TRUE(apply_replication_stream(fds[1]));
+    EXPECT_EQ(get_count_from_database(), 2);
+    EXPECT_TRUE(get_by_id_from_database(10086) == NULL);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10088)->name, "Zhangsan"), 0);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10088)->department, "ZTA"), 0);
+    get_replication_stat(&stat);
+    EXPECT_TRUE(stat.is_synced);
+    EXPECT_EQ(stat.sequence, 3);
+    EXPECT_EQ(stat.buffered, 0);
+
+    // 失败的批处理不推送任何变更，提交成功的批处理整体推送
+    query_info_t batch = {
+        .command = CMD_BEGIN,
+    };
+    bzero(&request, sizeof(user_request_t));
+    execute_input_command(&batch, &request);
+    batch.command = CMD_MOD;
+    batch.info.staff_id = 10088;
+    batch.info.department = mem_strndup(MEM_STRING, "CWPP", 4);
+    execute_input_command(&batch, &request);
+    batch.command = CMD_DEL;
+    batch.info.staff_id = 10099;
+    execute_input_command(&batch, &request);
+    batch.command = CMD_COMMIT;
+    execute_input_command(&batch, &request);
+    EXPECT_FALSE(request.is_success);
+    char peek = 0;
+    EXPECT_EQ(recv(fds[1], &peek, 1, MSG_PEEK | MSG_DONTWAIT), -1);
+    get_replication_stat(&stat);
+    EXPECT_EQ(stat.sequence, 3);
+
+    batch.command = CMD_BEGIN;
+    execute_input_command(&batch, &request);
+    batch.command = CMD_MOD;
+    batch.info.staff_id = 10088;
+    batch.info.department = mem_strndup(MEM_STRING, "CWPP", 4);
+    execute_input_command(&batch, &request);
+    batch.command = CMD_DEL;
+    batch.info.staff_id = 10087;
+    execute_input_command(&batch, &request);
+    batch.command = CMD_COMMIT;
+    execute_input_command(&batch, &request);
+    EXPECT_TRUE(request.is_success);
+    // 回滚本地数据后应用批处理
+    staff_info_t origin = {
+        .staff_id = 10087,
+        .name = (char *)"WangWu",
+    };
+    staff_info_t zta = {
+        .staff_id = 10088,
+        .department = (char *)"ZTA",
+    };
+    modify_item_from_database(&zta, false, NULL);
+    add_item_to_database(&origin);
+    EXPECT_TRUE(apply_replication_stream(fds[1]));
+    EXPECT_EQ(get_count_from_database(), 1);
+    EXPECT_EQ(strcmp(get_by_id_from_database(10088)->department, "CWPP"), 0);
+    get_replication_stat(&stat);
+    EXPECT_EQ(stat.sequence, 5);
+    EXPECT_EQ(stat.buffered, 0);
+
+    // 跟随者不接收时推送不阻塞，积压超出发送缓冲后移除跟随者
+    char name[1024];
+    memset(name, 'x', sizeof(name) - 1);
+    name[sizeof(name) - 1] = '\0';
+    info.name = name;
+    for (uint32_t i = 0; i < (1 << 20) && stat.followers == 1; i++) {
+        publish_replication(REPL_OP_ADD, &info);
+        get_replication_stat(&stat);
+    }
+    EXPECT_EQ(stat.followers, 0);
+
+    // 跟随者只读，拒绝写入但可查询
+    ASSERT_TRUE(init_replication(REPL_FOLLOWER, 0));
+    close(fds[1]);
+    EXPECT_TRUE(is_replication_read_only());
+    bzero(&request, sizeof(user_request_t));
+    query.command = CMD_ADD;
+    query.info.staff_id = 10089;
+    execute_input_command(&query, &request);
+    EXPECT_FALSE(request.is_success);
+    EXPECT_TRUE(get_by_id_from_database(10089) == NULL);
+    bzero(&request, sizeof(user_request_t));
+    query.command = CMD_STAT;
+    execute_input_command(&query, &request);
+    EXPECT_TRUE(strstr(request.result, "Replication: role [follower]") != NULL);
+
+    // 字符串未在帧内结尾或帧长超出上限时数据流视为损坏，不应用任何变更
+    char frame[256];
+    uint32_t huge = UINT32_MAX;
+    info.name = (char *)"Lisi";
+    info.staff_id = 10089;
+    uint32_t size = encode_frame(REPL_OP_ADD, 4, &info, frame);
+    frame[size - 1] = 'x';
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+    EXPECT_EQ(send(fds[0], frame, size, 0), (ssize_t)size);
+    EXPECT_FALSE(apply_replication_stream(fds[1]));
+    ASSERT_TRUE(init_replication(REPL_FOLLOWER, 0));
+    encode_frame(REPL_OP_ADD, 4, &info, frame);
+    memcpy(frame, &huge, sizeof(huge));
+    EXPECT_EQ(send(fds[0], frame, size, 0), (ssize_t)size);
+    EXPECT_FALSE(apply_replication_stream(fds[1]));
+    EXPECT_TRUE(get_by_id_from_database(10089) == NULL);
+    close(fds[0]);
+    close(fds[1]);
+    uninit_replication();
+    EXPECT_FALSE(is_replication_read_only());
+}
+
 TEST_F(CommandExecTest, Log) {
     query_info_t query = {
         .command = CMD_LOG,
@@ -168,6 +1505,8 @@ TEST_F(CommandExecTest, Help) {
     bzero(&request, sizeof(user_request_t));
     execute_input_command(&query, &request);
     EXPECT_TRUE(request.is_success);
+    EXPECT_FALSE(strstr(get_request_result(&request), "The above commands are not case sensitive.") == NULL);
+    clear_request_result(&request);
 }
 
 TEST_F(CommandExecTest, Exit) {
@@ -176,7 +1515,10 @@ TEST_F(CommandExecTest, Exit) {
     };
     user_request_t request;
 
+    // 仅请求停止服务，资源由输入线程退出主循环后释放
     bzero(&request, sizeof(user_request_t));
     execute_input_command(&query, &request);
     EXPECT_TRUE(request.is_success);
+    EXPECT_EQ(strcmp(request.result, "Process is over, now quit."), 0);
+    EXPECT_EQ(get_count_from_database(), 2);
 }
@@ -12,10 +12,17 @@ extern "C" {
 #include "command_execution.h"
 #include "command_parser.h"
 #include "common.h"
+#include "mem_stat.h"
 
 extern uint8_t get_split_params(const char *string, char params[][BUFSIZ]);
 extern bool is_name_valid(const char *string);
-extern sort_type_t parse_sort_type(const char *string);
+extern bool parse_sort_order(const char *string, sort_order_t *order);
+extern group_type_t parse_group_type(const char *string);
+extern bool parse_page_option(const char *string, query_info_t *query_info);
+extern bool parse_name_pattern(const char *string, query_info_t *query_info);
+extern bool parse_distance_option(const char *string, query_info_t *query_info);
+extern bool parse_range_option(const char *string, query_info_t *query_info);
+extern bool parse_id_list(const char *string, query_info_t *query_info);
 extern bool parse_log_level(const char *string);
 extern info_type_t parse_info_type(const char *string, size_t *end);
 extern bool parse_staff_info(const char *string, staff_info_t *info);
@@ -56,19 +63,176 @@ TEST_F(CommandParserTest, CheckInfoValid) {
 }
 
 TEST_F(CommandParserTest, ParseSortType) {
-    sort_type_t type = SORT_NONE;
+    sort_order_t order;
+    bzero(&order, sizeof(sort_order_t));
 
-    type = parse_sort_type("--sort:id");
-    EXPECT_EQ(type, SORT_ID);
+    EXPECT_TRUE(parse_sort_order("--sort:id", &order));
+    EXPECT_EQ(order.count, 1);
+    EXPECT_EQ(order.types[0], SORT_ID);
+    EXPECT_FALSE(order.is_desc[0]);
 
-    type = parse_sort_type("--sort:date");
-    EXPECT_EQ(type, SORT_DATE);
+    EXPECT_TRUE(parse_sort_order("--sort:dept,date:desc,name:asc", &order));
+    EXPECT_EQ(order.count, 3);
+    EXPECT_EQ(order.types[0], SORT_DEPT);
+    EXPECT_EQ(order.types[1], SORT_DATE);
+    EXPECT_EQ(order.types[2], SORT_NAME);
+    EXPECT_FALSE(order.is_desc[0]);
+    EXPECT_TRUE(order.is_desc[1]);
+    EXPECT_FALSE(order.is_desc[2]);
 
-    type = parse_sort_type("--sort:name");
-    EXPECT_EQ(type, SORT_NONE);
+    // 失败时不修改已有规则
+    EXPECT_FALSE(parse_sort_order("--sort:id,id", &order));
+    EXPECT_FALSE(parse_sort_order("--sort:date:down", &order));
+    EXPECT_FALSE(parse_sort_order("--sort:salary", &order));
+    EXPECT_FALSE(parse_sort_order("--sort:", &order));
+    EXPECT_FALSE(parse_sort_order("invalid", &order));
+    EXPECT_EQ(order.count, 3);
+}
+
+TEST_F(CommandParserTest, ParseGroupType) {
+    EXPECT_EQ(parse_group_type("--group:dept"), GROUP_DEPT);
+    EXPECT_EQ(parse_group_type("--group:pos"), GROUP_POS);
+    EXPECT_EQ(parse_group_type("--group:year"), GROUP_YEAR);
+    EXPECT_EQ(parse_group_type("--group:name"), GROUP_NONE);
+    EXPECT_EQ(parse_group_type("invalid"), GROUP_NONE);
+}
+
+TEST_F(CommandParserTest, ParsePageOption) {
+    query_info_t query_info;
+
+    bzero(&query_info, sizeof(query_info_t));
+    EXPECT_TRUE(parse_page_option("--limit:50", &query_info));
+    EXPECT_EQ(query_info.limit, 50);
+    EXPECT_TRUE(parse_page_option("--offset:0", &query_info));
+    EXPECT_EQ(query_info.offset, 0);
+    EXPECT_TRUE(parse_page_option("--offset:100", &query_info));
+    EXPECT_EQ(query_info.offset, 100);
+
+    EXPECT_FALSE(parse_page_option("--limit:0", &query_info));
+    EXPECT_FALSE(parse_page_option("--limit:-1", &query_info));
+    EXPECT_FALSE(parse_page_option("--limit:5x", &query_info));
+    EXPECT_FALSE(parse_page_option("--offset:", &query_info));
+}
+
+TEST_F(CommandParserTest, ParseRangeOption) {
+    query_info_t query_info;
+
+    bzero(&query_info, sizeof(query_info_t));
+    EXPECT_TRUE(parse_range_option("--from:2020-01-01", &query_info));
+    EXPECT_TRUE(parse_range_option("--to:2021-12-31", &query_info));
+    EXPECT_LT(query_info.date_from, query_info.date_to);
+    EXPECT_TRUE(parse_range_option("--dry", &query_info));
+    EXPECT_TRUE(query_info.is_dry_run);
+
+    EXPECT_FALSE(parse_range_option("--from:", &query_info));
+    EXPECT_FALSE(parse_range_option("--to:2021", &query_info));
+    EXPECT_FALSE(parse_range_option("--dryrun", &query_info));
+
+    // 删除须指定范围，日期区间不可为空
+    EXPECT_FALSE(parse_user_input("DEL\n", STDIN_FILENO, &query_info));
+    EXPECT_FALSE(parse_user_input("DEL --dry\n", STDIN_FILENO, &query_info));
+    EXPECT_FALSE(parse_user_input("DEL --from:2021-01-01 --to:2020-01-01\n", STDIN_FILENO, &query_info));
+    EXPECT_FALSE(parse_user_input("GET --from:2020-01-01\n", STDIN_FILENO, &query_info));
+    EXPECT_TRUE(parse_user_input("DEL dept:ZTA --from:2020-01-01 --dry\n", STDIN_FILENO, &query_info));
+    EXPECT_TRUE(query_info.is_dry_run);
+    FREE(query_info.info.department)
+}
+
+TEST_F(CommandParserTest, ParseIdList) {
+    query_info_t query_info;
+    char path[] = "/tmp/em_ids_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    const char ids[] = "10086\n10087, 10088\n";
+    write(fd, ids, strlen(ids));
+    close(fd);
+
+    bzero(&query_info, sizeof(query_info_t));
+    EXPECT_TRUE(parse_id_list("id:1,2,3", &query_info));
+    EXPECT_EQ(query_info.id_count, 3);
+    EXPECT_EQ(query_info.staff_ids[2], 3);
+    // 工号文件依次追加
+    char option[64] = {0};
+    snprintf(option, sizeof(option), "--ids:%s", path);
+    EXPECT_TRUE(parse_id_list(option, &query_info));
+    EXPECT_EQ(query_info.id_count, 6);
+    EXPECT_EQ(query_info.staff_ids[5], 10088);
+    MEM_FREE(MEM_RESULT, query_info.staff_ids)
+    query_info.id_count = 0;
 
-    type = parse_sort_type("invalid");
-    EXPECT_EQ(type, SORT_NONE);
+    // 远程请求不得读取服务端文件
+    query_info.is_remote = true;
+    EXPECT_FALSE(parse_id_list(option, &query_info));
+    EXPECT_EQ(query_info.id_count, 0);
+    EXPECT_TRUE(parse_id_list("id:1,2", &query_info));
+    MEM_FREE(MEM_RESULT, query_info.staff_ids)
+    snprintf(option, sizeof(option), "GET --ids:%s\n", path);
+    EXPECT_FALSE(parse_user_input(option, 5, &query_info));
+    EXPECT_EQ(query_info.id_count, 0);
+    EXPECT_TRUE(parse_user_input(option, STDIN_FILENO, &query_info));
+    EXPECT_EQ(query_info.id_count, 3);
+    MEM_FREE(MEM_RESULT, query_info.staff_ids)
+    bzero(&query_info, sizeof(query_info_t));
+
+    // 单个工号由员工信息解析
+    EXPECT_FALSE(parse_id_list("id:1", &query_info));
+    EXPECT_FALSE(parse_id_list("id:1,x", &query_info));
+    EXPECT_FALSE(parse_id_list("id:1,0", &query_info));
+    EXPECT_FALSE(parse_id_list("--ids:/nonexistent/ids", &query_info));
+    MEM_FREE(MEM_RESULT, query_info.staff_ids)
+    EXPECT_FALSE(parse_user_input("GET id:1,x\n", STDIN_FILENO, &query_info));
+    MEM_FREE(MEM_RESULT, query_info.staff_ids)
+    EXPECT_FALSE(parse_user_input("ADD id:1,2 name:Lisi\n", STDIN_FILENO, &query_info));
+    MEM_FREE(MEM_STRING, query_info.info.name)
+    unlink(path);
+}
+
+TEST_F(CommandParserTest, ParseNamePattern) {
+    query_info_t query_info;
+
+    bzero(&query_info, sizeof(query_info_t));
+    EXPECT_TRUE(parse_name_pattern("name~:Zha", &query_info));
+    EXPECT_EQ(query_info.name_match, NAME_PREFIX);
+    EXPECT_EQ(strcmp(query_info.info.name, "Zha"), 0);
+    EXPECT_TRUE(parse_name_pattern("name%:ang", &query_info));
+    EXPECT_EQ(query_info.name_match, NAME_SUBSTR);
+    EXPECT_EQ(strcmp(query_info.info.name, "ang"), 0);
+    EXPECT_TRUE(parse_name_pattern("name?:Zhangsn", &query_info));
+    EXPECT_EQ(query_info.name_match, NAME_FUZZY);
+    FREE(query_info.info.name)
+    EXPECT_TRUE(parse_distance_option("--dist:1", &query_info));
+    EXPECT_EQ(query_info.max_distance, 1);
+    EXPECT_FALSE(parse_distance_option("--dist:0", &query_info));
+    EXPECT_FALSE(parse_distance_option("--dist:5", &query_info));
+
+    EXPECT_FALSE(parse_name_pattern("name:Zha", &query_info));
+    EXPECT_FALSE(parse_name_pattern("name~:", &query_info));
+    EXPECT_FALSE(parse_name_pattern("name%:a1", &query_info));
+}
+
+TEST_F(CommandParserTest, ParsePriority) {
+    query_info_t query_info;
+
+    // 按工号查询及单条增删改为高优先级
+    EXPECT_TRUE(parse_user_input("GET id:10086\n", STDIN_FILENO, &query_info));
+    EXPECT_EQ(query_info.priority, PRIORITY_HIGH);
+    EXPECT_TRUE(parse_user_input("GET id:1,2\n", STDIN_FILENO, &query_info));
+    EXPECT_EQ(query_info.priority, PRIORITY_HIGH);
+    MEM_FREE(MEM_RESULT, query_info.staff_ids)
+    EXPECT_TRUE(parse_user_input("DEL id:10086\n", STDIN_FILENO, &query_info));
+    EXPECT_EQ(query_info.priority, PRIORITY_HIGH);
+    EXPECT_TRUE(parse_user_input("STAT\n", STDIN_FILENO, &query_info));
+    EXPECT_EQ(query_info.priority, PRIORITY_HIGH);
+
+    // 遍历查询、导出、批量删除及批处理提交为低优先级
+    EXPECT_TRUE(parse_user_input("GET *\n", STDIN_FILENO, &query_info));
+    EXPECT_EQ(query_info.priority, PRIORITY_LOW);
+    EXPECT_TRUE(parse_user_input("EXPORT\n", STDIN_FILENO, &query_info));
+    EXPECT_EQ(query_info.priority, PRIORITY_LOW);
+    EXPECT_TRUE(parse_user_input("DEL *\n", STDIN_FILENO, &query_info));
+    EXPECT_EQ(query_info.priority, PRIORITY_LOW);
+    EXPECT_TRUE(parse_user_input("COMMIT\n", STDIN_FILENO, &query_info));
+    EXPECT_EQ(query_info.priority, PRIORITY_LOW);
 }
 
 TEST_F(CommandParserTest, ParseLogLevel) {
@@ -125,33 +289,43 @@ TEST_F(CommandParserTest, ParseCommand) {
 TEST_F(CommandParserTest, ParseInput) {
     query_info_t query_info;
 
-    parse_user_input("ADD id:10086 name:Zhangsan\n", &query_info);
+    parse_user_input("ADD id:10086 name:Zhangsan\n", STDIN_FILENO, &query_info);
     EXPECT_EQ(query_info.command, CMD_ADD);
     EXPECT_EQ(query_info.info.staff_id, 10086);
     EXPECT_EQ(strcmp(query_info.info.name, "Zhangsan"), 0);
     FREE(query_info.info.name)
 
-    parse_user_input("DEL id:10086\n", &query_info);
+    parse_user_input("DEL id:10086\n", STDIN_FILENO, &query_info);
     EXPECT_EQ(query_info.command, CMD_DEL);
     EXPECT_EQ(query_info.info.staff_id, 10086);
 
-    parse_user_input("MOD id:10086 name:Lisi\n", &query_info);
+    parse_user_input("MOD id:10086 name:Lisi\n", STDIN_FILENO, &query_info);
     EXPECT_EQ(query_info.command, CMD_MOD);
     EXPECT_EQ(query_info.info.staff_id, 10086);
     EXPECT_EQ(strcmp(query_info.info.name, "Lisi"), 0);
     FREE(query_info.info.name)
 
-    parse_user_input("GET --sort:id *\n", &query_info);
+    parse_user_input("GET --sort:id *\n", STDIN_FILENO, &query_info);
     EXPECT_EQ(query_info.command, CMD_GET);
-    EXPECT_EQ(query_info.sort_type, SORT_ID);
+    EXPECT_EQ(query_info.sort_order.count, 1);
+    EXPECT_EQ(query_info.sort_order.types[0], SORT_ID);
     EXPECT_TRUE(query_info.is_opt_all);
 
-    parse_user_input("LOG debug\n", &query_info);
+    parse_user_input("EXPORT --format:jsonl --file:/tmp/staffs.jsonl dept:CWPP\n", STDIN_FILENO, &query_info);
+    EXPECT_EQ(query_info.command, CMD_EXPORT);
+    EXPECT_EQ(query_info.export_format, EXPORT_JSONL);
+    EXPECT_EQ(strcmp(query_info.export_path, "/tmp/staffs.jsonl"), 0);
+    EXPECT_EQ(strcmp(query_info.info.department, "CWPP"), 0);
+    FREE(query_info.export_path)
+    FREE(query_info.info.department)
+    EXPECT_FALSE(parse_user_input("EXPORT --format:xml *\n", STDIN_FILENO, &query_info));
+
+    parse_user_input("LOG debug\n", STDIN_FILENO, &query_info);
     EXPECT_EQ(query_info.command, CMD_LOG);
-    parse_user_input("LOG info\n", &query_info);
+    parse_user_input("LOG info\n", STDIN_FILENO, &query_info);
 
-    EXPECT_FALSE(parse_user_input("NUL\n", &query_info));
-    EXPECT_FALSE(parse_user_input("LOG idddd\n", &query_info));
+    EXPECT_FALSE(parse_user_input("NUL\n", STDIN_FILENO, &query_info));
+    EXPECT_FALSE(parse_user_input("LOG idddd\n", STDIN_FILENO, &query_info));
 
     // 超长输入
     char long_cmd[2048];
@@ -159,5 +333,5 @@ TEST_F(CommandParserTest, ParseInput) {
         strcat(long_cmd, "long");
     }
     long_cmd[2044] = '\n';
-    EXPECT_FALSE(parse_user_input(long_cmd, &query_info));
+    EXPECT_FALSE(parse_user_input(long_cmd, STDIN_FILENO, &query_info));
 }